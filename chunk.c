@@ -0,0 +1,380 @@
+#include "chunk.h"
+
+#include "errno.h"
+#include "fcntl.h"
+#include "limits.h"
+#include "unistd.h"
+#include "sys/mman.h"
+#include "sys/stat.h"
+
+int chunk_open(const char *);
+int chunk_file(struct chunk *, int, const char *);
+int chunk_read(int, char *, size_t, size_t *);
+int chunk_fill(struct chunk *, int);
+char * chunk_last(char *, char *, const char *);
+char * chunk_record(char *, char *, const char *);
+void * chunk_thread(void *);
+
+/*
+ * "-" is the standard input and "fd:N" is descriptor N,
+ * anything else is a path
+ */
+int chunk_open(const char * path) {
+    char * last;
+    long file;
+
+    if(!strcmp(path, "-"))
+        return dup(STDIN_FILENO);
+
+    if(!strncmp(path, "fd:", 3)) {
+        file = strtol(path + 3, &last, 10);
+        if(last == path + 3 || *last || file < 0 || file > INT_MAX)
+            return -1;
+
+        return dup(file);
+    }
+
+    return open(path, O_RDONLY);
+}
+
+/*
+ * a regular file is mapped, anything else is read to
+ * the end into a buffer that grows as needed
+ */
+int chunk_file(struct chunk * chunk, int file, const char * path) {
+    int status = 0;
+
+    struct stat info;
+
+    chunk->buffer = NULL;
+    chunk->length = 0;
+    chunk->line = 1;
+    chunk->mapped = 0;
+    chunk->keep = 0;
+
+    if(fstat(file, &info)) {
+        status = panic("failed to stat %s", path);
+    } else if(S_ISREG(info.st_mode)) {
+        chunk->length = info.st_size;
+        chunk->mapped = 1;
+
+        if(chunk->length) {
+            chunk->buffer = mmap(NULL, chunk->length, PROT_READ, MAP_PRIVATE, file, 0);
+            if(chunk->buffer == MAP_FAILED) {
+                chunk->buffer = NULL;
+                status = panic("failed to map %s", path);
+            } else {
+                madvise(chunk->buffer, chunk->length, MADV_WILLNEED);
+            }
+        }
+    } else {
+        chunk->size = 0;
+
+        do {
+            if(chunk_fill(chunk, file))
+                status = panic("failed to read %s", path);
+        } while(!status && chunk->length == chunk->size);
+
+        if(status)
+            free(chunk->buffer);
+    }
+
+    if(!status) {
+        chunk->begin = chunk->buffer;
+        chunk->end = chunk->buffer + chunk->length;
+        chunk->context = NULL;
+        chunk->status = 0;
+        chunk->callback = NULL;
+    }
+
+    return status;
+}
+
+int chunk_map(struct chunk * chunk, const char * path) {
+    int status = 0;
+
+    int file;
+
+    file = chunk_open(path);
+    if(file < 0) {
+        status = panic("failed to open %s", path);
+    } else {
+        if(chunk_file(chunk, file, path))
+            status = panic("failed to file chunk object");
+
+        close(file);
+    }
+
+    return status;
+}
+
+void chunk_unmap(struct chunk * chunk) {
+    if(chunk->mapped) {
+        if(chunk->buffer)
+            munmap(chunk->buffer, chunk->length);
+    } else {
+        free(chunk->buffer);
+    }
+}
+
+/*
+ * read until buffer holds size bytes or the end of file,
+ * *length is the number of bytes in buffer
+ */
+int chunk_read(int file, char * buffer, size_t size, size_t * length) {
+    ssize_t count;
+
+    while(*length < size) {
+        count = read(file, buffer + *length, size - *length);
+        if(count < 0) {
+            if(errno != EINTR)
+                return panic("failed to read file - %s", strerror(errno));
+        } else if(!count) {
+            break;
+        } else {
+            *length += count;
+        }
+    }
+
+    return 0;
+}
+
+/*
+ * double the buffer of chunk if it is full and read into it,
+ * chunk->length is less than chunk->size at the end of file
+ */
+int chunk_fill(struct chunk * chunk, int file) {
+    int status = 0;
+
+    size_t size;
+    char * buffer;
+
+    if(chunk->length == chunk->size) {
+        size = chunk->size ? chunk->size * 2 : CHUNK_COUNT * CHUNK_SIZE;
+        buffer = realloc(chunk->buffer, size);
+        if(!buffer) {
+            status = panic("out of memory");
+        } else {
+            chunk->buffer = buffer;
+            chunk->size = size;
+        }
+    }
+
+    if(!status && chunk_read(file, chunk->buffer, chunk->size, &chunk->length))
+        status = panic("failed to read chunk object");
+
+    return status;
+}
+
+/*
+ * call callback on the whole file if it is regular, or
+ * else on each batch of whole records as they are read;
+ * a batch ends before the last line that begins with
+ * mark, so a stream is held in a buffer of one batch
+ * that only grows for a record larger than it; the
+ * callback sets keep to own the mapping of a file
+ */
+int chunk_stream(const char * path, const char * mark, chunk_cb callback, void * context) {
+    int status = 0;
+
+    int file;
+    size_t length;
+    struct stat info;
+    struct chunk chunk;
+    char * last;
+
+    file = chunk_open(path);
+    if(file < 0) {
+        status = panic("failed to open %s", path);
+    } else {
+        if(fstat(file, &info)) {
+            status = panic("failed to stat %s", path);
+        } else if(S_ISREG(info.st_mode)) {
+            if(chunk_file(&chunk, file, path)) {
+                status = panic("failed to file chunk object");
+            } else {
+                if(callback(&chunk, context))
+                    status = panic("failed to process %s", path);
+
+                if(!chunk.keep)
+                    chunk_unmap(&chunk);
+            }
+        } else {
+            chunk.buffer = NULL;
+            chunk.length = 0;
+            chunk.size = 0;
+            chunk.line = 1;
+            chunk.mapped = 0;
+            chunk.keep = 0;
+            chunk.context = NULL;
+            chunk.status = 0;
+            chunk.callback = NULL;
+
+            do {
+                if(chunk_fill(&chunk, file)) {
+                    status = panic("failed to read %s", path);
+                } else {
+                    last = chunk.buffer + chunk.length;
+                    if(chunk.length == chunk.size)
+                        last = chunk_last(chunk.buffer, last, mark);
+
+                    if(last > chunk.buffer) {
+                        chunk.begin = chunk.buffer;
+                        chunk.end = last;
+
+                        if(callback(&chunk, context)) {
+                            status = panic("failed to process %s (line %zu)", path, chunk.line);
+                        } else {
+                            length = last - chunk.buffer;
+                            chunk.line = chunk_lineno(&chunk, last);
+                            memmove(chunk.buffer, last, chunk.length - length);
+                            chunk.length -= length;
+                        }
+                    }
+                }
+            } while(!status && chunk.length);
+
+            free(chunk.buffer);
+        }
+        close(file);
+    }
+
+    return status;
+}
+
+/*
+ * return the start of the last line after begin that
+ * begins with mark, or begin if there is none
+ */
+char * chunk_last(char * begin, char * end, const char * mark) {
+    size_t length;
+    char * iter;
+
+    length = strlen(mark);
+    iter = end;
+    while(--iter > begin)
+        if(iter[-1] == '\n' && end - iter >= length && !memcmp(iter, mark, length))
+            return iter;
+
+    return begin;
+}
+
+/*
+ * return the start of the first line at or after iter
+ * that begins with mark, or end if there is none
+ */
+char * chunk_record(char * iter, char * end, const char * mark) {
+    size_t length;
+
+    length = strlen(mark);
+    while(iter < end) {
+        iter = memchr(iter, '\n', end - iter);
+        if(!iter)
+            return end;
+        iter++;
+        if(end - iter >= length && !memcmp(iter, mark, length))
+            return iter;
+    }
+
+    return end;
+}
+
+/*
+ * split chunk into at most *count chunks of no less than
+ * CHUNK_SIZE bytes; every chunk but the first starts at a
+ * line that begins with mark, i.e. "" for one record per
+ * line and "- " for a top-level yaml sequence
+ */
+int chunk_split(struct chunk * chunk, const char * mark, struct chunk * array, size_t * count) {
+    int status = 0;
+
+    size_t i = 0;
+    size_t total;
+    size_t length;
+    char * iter;
+    char * next;
+
+    if(!*count) {
+        status = panic("invalid count");
+    } else {
+        length = chunk->end - chunk->begin;
+        total = length / CHUNK_SIZE;
+        if(total > *count)
+            total = *count;
+        if(!total)
+            total = 1;
+
+        iter = chunk->begin;
+        while(iter < chunk->end || !i) {
+            if(i + 1 < total) {
+                next = chunk_record(chunk->begin + length / total * (i + 1), chunk->end, mark);
+                if(next < iter)
+                    next = iter;
+            } else {
+                next = chunk->end;
+            }
+
+            array[i] = *chunk;
+            array[i].begin = iter;
+            array[i].end = next;
+            iter = next;
+            i++;
+        }
+        *count = i;
+    }
+
+    return status;
+}
+
+void * chunk_thread(void * context) {
+    struct chunk * chunk = context;
+
+    chunk->status = chunk->callback(chunk, chunk->context);
+
+    return NULL;
+}
+
+/*
+ * call callback on every chunk, the first on the calling
+ * thread; a chunk whose thread cannot start runs inline
+ */
+int chunk_run(struct chunk * array, size_t count, chunk_cb callback) {
+    int status = 0;
+    size_t i;
+
+    for(i = 1; i < count; i++) {
+        array[i].callback = callback;
+        if(pthread_create(&array[i].thread, NULL, chunk_thread, &array[i])) {
+            array[i].callback = NULL;
+            array[i].status = callback(&array[i], array[i].context);
+        }
+    }
+
+    if(count)
+        array[0].status = callback(&array[0], array[0].context);
+
+    for(i = 1; i < count; i++)
+        if(array[i].callback)
+            pthread_join(array[i].thread, NULL);
+
+    for(i = 0; i < count; i++)
+        if(array[i].status)
+            status = panic("failed to process chunk %zu (line %zu)", i, chunk_lineno(&array[i], array[i].begin));
+
+    return status;
+}
+
+size_t chunk_lineno(struct chunk * chunk, char * iter) {
+    size_t line = chunk->line;
+    char * scan = chunk->buffer;
+
+    while(scan < iter) {
+        scan = memchr(scan, '\n', iter - scan);
+        if(!scan)
+            break;
+        line++;
+        scan++;
+    }
+
+    return line;
+}
@@ -0,0 +1,42 @@
+#ifndef chunk_h
+#define chunk_h
+
+#include "utility.h"
+
+#include "pthread.h"
+
+#ifndef CHUNK_COUNT
+#define CHUNK_COUNT 4
+#endif
+
+#ifndef CHUNK_SIZE
+#define CHUNK_SIZE 65536
+#endif
+
+struct chunk;
+
+typedef int (* chunk_cb) (struct chunk *, void *);
+
+struct chunk {
+    char * buffer;
+    size_t length;
+    size_t size;
+    size_t line;
+    int mapped;
+    int keep;
+    char * begin;
+    char * end;
+    void * context;
+    int status;
+    pthread_t thread;
+    chunk_cb callback;
+};
+
+int chunk_map(struct chunk *, const char *);
+void chunk_unmap(struct chunk *);
+int chunk_stream(const char *, const char *, chunk_cb, void *);
+int chunk_split(struct chunk *, const char *, struct chunk *, size_t *);
+int chunk_run(struct chunk *, size_t, chunk_cb);
+size_t chunk_lineno(struct chunk *, char *);
+
+#endif
@@ -1,33 +1,267 @@
 #include "csv.h"
 
-#include "csv_scanner.h"
+#include "limits.h"
 
-int csv_parse(const char * path, parser_cb callback, void * context) {
+#if defined(__AVX2__)
+#include "immintrin.h"
+#define CSV_WIDTH 32
+#elif defined(__SSE2__)
+#include "emmintrin.h"
+#define CSV_WIDTH 16
+#endif
+
+/*
+ * csv_text is TEXTDATA of the former flex scanner,
+ * i.e. tab and 0x20-0x7E except quote, comma and curly
+ */
+enum csv_class {
+    csv_text = 0x1,
+    csv_space = 0x2
+};
+
+static const unsigned char csv_class[256] = {
+    ['\t'] = csv_text | csv_space,
+    [' '] = csv_text | csv_space,
+    ['!'] = csv_text,
+    ['#' ... '+'] = csv_text,
+    ['-' ... 'z'] = csv_text,
+    ['|'] = csv_text,
+    ['~'] = csv_text
+};
+
+char * csv_scan(char *, char *, int);
+char * csv_line(char *, char *);
+char * csv_eol(char *, char *);
+int csv_column(struct csv *, int *);
+int csv_select(struct csv *);
+int csv_field(struct csv *, char *, size_t);
+int csv_lex(struct csv *);
+int csv_stream(struct chunk *, void *);
+
+/*
+ * return the first byte that is not text;
+ * a comma is text inside a quoted field
+ */
+char * csv_scan(char * iter, char * end, int comma) {
+#if defined(__AVX2__)
+    __m256i x;
+    __m256i m;
+    unsigned int mask;
+
+    while(iter + CSV_WIDTH <= end) {
+        x = _mm256_loadu_si256((__m256i *) iter);
+        m = _mm256_cmpgt_epi8(_mm256_set1_epi8(0x20), x);
+        m = _mm256_andnot_si256(_mm256_cmpeq_epi8(x, _mm256_set1_epi8('\t')), m);
+        m = _mm256_or_si256(m, _mm256_cmpeq_epi8(x, _mm256_set1_epi8(0x7F)));
+        m = _mm256_or_si256(m, _mm256_cmpeq_epi8(x, _mm256_set1_epi8('"')));
+        m = _mm256_or_si256(m, _mm256_cmpeq_epi8(x, _mm256_set1_epi8('{')));
+        m = _mm256_or_si256(m, _mm256_cmpeq_epi8(x, _mm256_set1_epi8('}')));
+        if(!comma)
+            m = _mm256_or_si256(m, _mm256_cmpeq_epi8(x, _mm256_set1_epi8(',')));
+        mask = _mm256_movemask_epi8(m);
+        if(mask)
+            return iter + __builtin_ctz(mask);
+        iter += CSV_WIDTH;
+    }
+#elif defined(__SSE2__)
+    __m128i x;
+    __m128i m;
+    unsigned int mask;
+
+    while(iter + CSV_WIDTH <= end) {
+        x = _mm_loadu_si128((__m128i *) iter);
+        m = _mm_cmplt_epi8(x, _mm_set1_epi8(0x20));
+        m = _mm_andnot_si128(_mm_cmpeq_epi8(x, _mm_set1_epi8('\t')), m);
+        m = _mm_or_si128(m, _mm_cmpeq_epi8(x, _mm_set1_epi8(0x7F)));
+        m = _mm_or_si128(m, _mm_cmpeq_epi8(x, _mm_set1_epi8('"')));
+        m = _mm_or_si128(m, _mm_cmpeq_epi8(x, _mm_set1_epi8('{')));
+        m = _mm_or_si128(m, _mm_cmpeq_epi8(x, _mm_set1_epi8('}')));
+        if(!comma)
+            m = _mm_or_si128(m, _mm_cmpeq_epi8(x, _mm_set1_epi8(',')));
+        mask = _mm_movemask_epi8(m);
+        if(mask)
+            return iter + __builtin_ctz(mask);
+        iter += CSV_WIDTH;
+    }
+#endif
+    while(iter < end && ((csv_class[(unsigned char) *iter] & csv_text) || (comma && *iter == ',')))
+        iter++;
+
+    return iter;
+}
+
+char * csv_line(char * iter, char * end) {
+    iter = memchr(iter, '\n', end - iter);
+    return iter ? iter : end;
+}
+
+char * csv_eol(char * iter, char * end) {
+    char * line;
+    char * feed;
+
+    line = csv_line(iter, end);
+    feed = memchr(iter, '\r', line - iter);
+
+    return feed ? feed : line;
+}
+
+int csv_field(struct csv * csv, char * string, size_t length) {
     int status = 0;
+    struct string field = { length, string };
 
-    FILE * file;
-    yyscan_t scanner;
-    struct csv csv;
+    if(!csv->index) {
+        if(csv->callback(parser_start, 0, NULL, csv->context)) {
+            status = panic("failed to process list start event");
+        } else {
+            csv->index = 1;
+        }
+    }
 
-    file = fopen(path, "r");
-    if(!file) {
-        status = panic("failed to open %s", path);
-    } else {
-        if(csvlex_init_extra(&csv, &scanner)) {
-            status = panic("failed to create scanner object");
+    if(!status && csv_select(csv)) {
+        if(csv->callback(parser_next, csv->index, &field, csv->context))
+            status = panic("failed to process scalar event");
+    }
+
+    return status;
+}
+
+/*
+ * same tokens as the former flex scanner; fields point into
+ * the buffer and only selected columns reach the callback,
+ * the rest of a line after the last one is not scanned
+ */
+int csv_lex(struct csv * csv) {
+    int status = 0;
+    char * iter;
+    char * end;
+    char * text;
+    char * space;
+
+    iter = csv->chunk->begin;
+    end = csv->chunk->end;
+    while(iter < end && !status) {
+        if(*iter == ',') {
+            csv->index++;
+            iter++;
+            if(csv->index > csv->last)
+                iter = csv_eol(iter, end);
+        } else if(*iter == '\r' || *iter == '\n') {
+            if(iter[0] == '\r' && iter + 1 < end && iter[1] == '\n')
+                iter++;
+            iter++;
+            if(csv->index) {
+                if(csv->callback(parser_end, 0, NULL, csv->context)) {
+                    status = panic("failed to process list end event");
+                } else {
+                    csv->index = 0;
+                }
+            }
+        } else if(*iter == '{') {
+            text = csv_line(iter, end);
+            if(csv_field(csv, iter, text - iter))
+                status = panic("failed to process field");
+            iter = text;
+        } else if(*iter == '"') {
+            text = csv_scan(iter + 1, end, 1);
+            if(text == end || *text != '"') {
+                status = panic("unmatch double quote (line %zu)", chunk_lineno(csv->chunk, iter));
+            } else if(csv_field(csv, iter + 1, text - iter - 1)) {
+                status = panic("failed to process field");
+            } else {
+                iter = text + 1;
+            }
+        } else if(csv_class[(unsigned char) *iter] & csv_text) {
+            space = iter;
+            while(space < end && csv_class[(unsigned char) *space] & csv_space)
+                space++;
+
+            if(space + 1 < end && space[0] == '/' && space[1] == '/') {
+                iter = csv_line(space, end);
+            } else {
+                text = csv_scan(space, end, 0);
+                if(text > space && csv_field(csv, iter, text - iter))
+                    status = panic("failed to process field");
+                iter = text;
+            }
         } else {
-            csvrestart(file, scanner);
+            status = panic("invalid character (line %zu)", chunk_lineno(csv->chunk, iter));
+        }
+    }
 
-            csv.index = 0;
-            csv.callback = callback;
-            csv.context = context;
+    return status;
+}
 
-            if(csvlex(scanner))
-                status = panic("failed to parse %s", path);
+int csv_column(struct csv * csv, int * column) {
+    int status = 0;
 
-            csvlex_destroy(scanner);
+    if(!column) {
+        csv->last = INT_MAX;
+        csv->column = ~0ULL;
+    } else {
+        csv->last = 0;
+        csv->column = 0;
+        while(*column && !status) {
+            if(*column < 0 || *column >= CSV_COLUMN) {
+                status = panic("invalid column - %d", *column);
+            } else {
+                if(csv->last < *column)
+                    csv->last = *column;
+                csv->column |= 1ULL << *column;
+                column++;
+            }
         }
-        fclose(file);
+    }
+
+    return status;
+}
+
+int csv_select(struct csv * csv) {
+    if(csv->index >= CSV_COLUMN)
+        return csv->column == ~0ULL;
+
+    return csv->column >> csv->index & 1;
+}
+
+int csv_chunk(struct chunk * chunk, int * column, parser_cb callback, void * context) {
+    int status = 0;
+    struct csv csv;
+
+    if(csv_column(&csv, column)) {
+        status = panic("failed to column csv object");
+    } else {
+        csv.index = 0;
+        csv.callback = callback;
+        csv.context = context;
+        csv.chunk = chunk;
+
+        if(csv_lex(&csv))
+            status = panic("failed to lex csv object");
+    }
+
+    return status;
+}
+
+int csv_stream(struct chunk * chunk, void * context) {
+    struct csv * csv = context;
+
+    csv->index = 0;
+    csv->chunk = chunk;
+
+    return csv_lex(csv);
+}
+
+int csv_parse(const char * path, int * column, parser_cb callback, void * context) {
+    int status = 0;
+    struct csv csv;
+
+    if(csv_column(&csv, column)) {
+        status = panic("failed to column csv object");
+    } else {
+        csv.callback = callback;
+        csv.context = context;
+
+        if(chunk_stream(path, "", csv_stream, &csv))
+            status = panic("failed to parse %s", path);
     }
 
     return status;
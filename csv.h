@@ -2,13 +2,20 @@
 #define csv_h
 
 #include "event.h"
+#include "chunk.h"
+
+#define CSV_COLUMN (sizeof(unsigned long long) * 8)
 
 struct csv {
     int index;
+    int last;
+    unsigned long long column;
     parser_cb callback;
     void * context;
+    struct chunk * chunk;
 };
 
-int csv_parse(const char *, parser_cb, void *);
+int csv_chunk(struct chunk *, int *, parser_cb, void *);
+int csv_parse(const char *, int *, parser_cb, void *);
 
 #endif
@@ -32,6 +32,8 @@ int pool_map_leak(struct pool_map * pool_map, struct pool * pool) {
         if(range_create(&range, &pool_map->range_pool)) {
             status = panic("failed to create range object");
         } else {
+            range.limit = 0;
+
             buffer = pool->buffer;
             while(buffer && !status) {
                 if(range_add(&range, (long) buffer->buffer, (long) buffer->buffer + (pool->size * pool->count) - 1))
@@ -161,8 +163,13 @@ int heap_create(struct heap * heap, size_t size) {
                     status = panic("failed to pool heap object");
                 } else {
                     heap->logic_pool = heap_pool(heap, sizeof(struct logic_node));
-                    if(!heap->logic_pool)
+                    if(!heap->logic_pool) {
                         status = panic("failed to pool heap object");
+                    } else {
+                        heap->term_pool = heap_pool(heap, sizeof(struct logic_term));
+                        if(!heap->term_pool)
+                            status = panic("failed to pool heap object");
+                    }
                 }
             }
         }
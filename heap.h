@@ -2,6 +2,7 @@
 #define heap_h
 
 #include "stack.h"
+#include "vector.h"
 #include "map.h"
 #include "range.h"
 #include "logic.h"
@@ -25,6 +26,7 @@ struct heap {
     struct pool * map_pool;
     struct pool * range_pool;
     struct pool * logic_pool;
+    struct pool * term_pool;
 };
 
 int heap_create(struct heap *, size_t);
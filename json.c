@@ -1,40 +1,406 @@
 #include "json.h"
 
 #include "json_parser.h"
-#include "json_scanner.h"
 
-int json_parse(const char * path, event_cb callback, void * context) {
+#if defined(__AVX2__)
+#include "immintrin.h"
+#define JSON_WIDTH 32
+#elif defined(__SSE2__)
+#include "emmintrin.h"
+#define JSON_WIDTH 16
+#endif
+
+int json_stream(struct json *);
+int json_scan(struct json *);
+int json_push(struct json *, int);
+char * json_string_end(char *, char *);
+int json_string(struct json *, char *);
+char * json_escape(struct strbuf *, char *, char *);
+char * json_unicode(struct strbuf *, char *, char *);
+int json_hex(char *, char *, unsigned int *);
+char * json_digit(char *, char *);
+char * json_number_end(char *, char *);
+
+int json_create(struct json * json, size_t size) {
     int status = 0;
 
-    FILE * file;
-    yyscan_t scanner;
-    struct json json;
+    if(strbuf_create(&json->strbuf, size))
+        status = panic("failed to create strbuf object");
+
+    return status;
+}
+
+void json_destroy(struct json * json) {
+    strbuf_destroy(&json->strbuf);
+}
+
+int json_chunk(struct json * json, struct chunk * chunk, event_cb callback, void * context) {
+    int status = 0;
 
-    file = fopen(path, "r");
-    if(!file) {
-        status = panic("failed to open %s", path);
+    json->parser = jsonpstate_new();
+    if(!json->parser) {
+        status = panic("failed to create parser object");
     } else {
-        if(jsonlex_init_extra(&json, &scanner)) {
-            status = panic("failed to create scanner object");
+        json->iter = chunk->begin;
+        json->end = chunk->end;
+        json->callback = callback;
+        json->context = context;
+
+        if(json_stream(json))
+            status = panic("failed to parse chunk (line %zu)", chunk_lineno(chunk, json->iter));
+
+        jsonpstate_delete(json->parser);
+    }
+
+    return status;
+}
+
+/*
+ * every token is pushed to the parser before its event
+ * is emitted, the end of input completes the document
+ */
+int json_stream(struct json * json) {
+    int status = 0;
+    int token;
+
+    token = json_scan(json);
+    while(token > 0 && !status) {
+        if(json_push(json, token)) {
+            status = panic("failed to push json object");
         } else {
-            json.parser = jsonpstate_new();
-            if(!json.parser) {
-                status = panic("failed to create parser object");
-            } else {
-                jsonrestart(file, scanner);
+            token = json_scan(json);
+        }
+    }
+
+    if(!status) {
+        if(token < 0) {
+            status = panic("invalid token");
+        } else if(jsonpush_parse(json->parser, JSON_YYEOF, NULL)) {
+            status = panic("unexpected end of file");
+        }
+    }
+
+    return status;
+}
+
+/*
+ * return the next token and leave iter after it, or at
+ * the start of the token if it is invalid; the text of a
+ * scalar is in view
+ */
+int json_scan(struct json * json) {
+    char * iter;
+    char * end;
+    char * text;
 
-                json.callback = callback;
-                json.context = context;
+    iter = json->iter;
+    end = json->end;
+    while(iter < end && (*iter == ' ' || *iter == '\t' || *iter == '\n' || *iter == '\r'))
+        iter++;
 
-                if(jsonlex(scanner))
-                    status = panic("failed to parse %s", path);
+    json->iter = iter;
+    if(iter >= end)
+        return 0;
 
-                jsonpstate_delete(json.parser);
+    switch(*iter) {
+        case '[': json->iter++; return JSON_BEGINARRAY;
+        case '{': json->iter++; return JSON_BEGINOBJECT;
+        case ']': json->iter++; return JSON_ENDARRAY;
+        case '}': json->iter++; return JSON_ENDOBJECT;
+        case ':': json->iter++; return JSON_NAMESEPARATOR;
+        case ',': json->iter++; return JSON_VALUESEPARATOR;
+        case '"': return json_string(json, iter + 1);
+        case 'f':
+            if(end - iter >= 5 && !memcmp(iter, "false", 5)) {
+                json->view.string = iter;
+                json->view.length = 5;
+                json->iter += 5;
+                return JSON_FALSE;
+            }
+            break;
+        case 'n':
+            if(end - iter >= 4 && !memcmp(iter, "null", 4)) {
+                json->view.string = iter;
+                json->view.length = 4;
+                json->iter += 4;
+                return JSON_NULL;
+            }
+            break;
+        case 't':
+            if(end - iter >= 4 && !memcmp(iter, "true", 4)) {
+                json->view.string = iter;
+                json->view.length = 4;
+                json->iter += 4;
+                return JSON_TRUE;
+            }
+            break;
+        default:
+            text = json_number_end(iter, end);
+            if(text) {
+                json->view.string = iter;
+                json->view.length = text - iter;
+                json->iter = text;
+                return JSON_NUMBER;
             }
-            jsonlex_destroy(scanner);
+            break;
+    }
+
+    return -1;
+}
+
+int json_push(struct json * json, int token) {
+    int status = 0;
+
+    if(YYPUSH_MORE != jsonpush_parse(json->parser, token, NULL)) {
+        status = panic("failed to push parse json object");
+    } else {
+        switch(token) {
+            case JSON_BEGINARRAY:
+                if(json->callback(event_list_start, NULL, json->context))
+                    status = panic("failed to process list start event");
+                break;
+            case JSON_BEGINOBJECT:
+                if(json->callback(event_map_start, NULL, json->context))
+                    status = panic("failed to process map start event");
+                break;
+            case JSON_ENDARRAY:
+                if(json->callback(event_list_end, NULL, json->context))
+                    status = panic("failed to process list end event");
+                break;
+            case JSON_ENDOBJECT:
+                if(json->callback(event_map_end, NULL, json->context))
+                    status = panic("failed to process map end event");
+                break;
+            case JSON_FALSE:
+            case JSON_NULL:
+            case JSON_TRUE:
+            case JSON_NUMBER:
+            case JSON_STRING:
+                if(json->callback(event_scalar, &json->view, json->context))
+                    status = panic("failed to process scalar event");
+                break;
         }
-        fclose(file);
     }
 
     return status;
 }
+
+/*
+ * return the first quotation mark, reverse solidus
+ * or control character at or after iter
+ */
+char * json_string_end(char * iter, char * end) {
+#if defined(__AVX2__)
+    __m256i x;
+    __m256i m;
+    unsigned int mask;
+
+    while(iter + JSON_WIDTH <= end) {
+        x = _mm256_loadu_si256((__m256i *) iter);
+        m = _mm256_cmpeq_epi8(_mm256_min_epu8(x, _mm256_set1_epi8(0x1F)), x);
+        m = _mm256_or_si256(m, _mm256_cmpeq_epi8(x, _mm256_set1_epi8('"')));
+        m = _mm256_or_si256(m, _mm256_cmpeq_epi8(x, _mm256_set1_epi8('\\')));
+        mask = _mm256_movemask_epi8(m);
+        if(mask)
+            return iter + __builtin_ctz(mask);
+        iter += JSON_WIDTH;
+    }
+#elif defined(__SSE2__)
+    __m128i x;
+    __m128i m;
+    unsigned int mask;
+
+    while(iter + JSON_WIDTH <= end) {
+        x = _mm_loadu_si128((__m128i *) iter);
+        m = _mm_cmpeq_epi8(_mm_min_epu8(x, _mm_set1_epi8(0x1F)), x);
+        m = _mm_or_si128(m, _mm_cmpeq_epi8(x, _mm_set1_epi8('"')));
+        m = _mm_or_si128(m, _mm_cmpeq_epi8(x, _mm_set1_epi8('\\')));
+        mask = _mm_movemask_epi8(m);
+        if(mask)
+            return iter + __builtin_ctz(mask);
+        iter += JSON_WIDTH;
+    }
+#endif
+    while(iter < end && *iter != '"' && *iter != '\\' && (unsigned char) *iter > 0x1F)
+        iter++;
+
+    return iter;
+}
+
+/*
+ * a string without escapes is a view into the input,
+ * otherwise it is decoded into strbuf
+ */
+int json_string(struct json * json, char * iter) {
+    char * end;
+    char * text;
+    struct string * string;
+
+    end = json->end;
+    text = json_string_end(iter, end);
+    if(text < end && *text == '"') {
+        json->view.string = iter;
+        json->view.length = text - iter;
+        json->iter = text + 1;
+        return JSON_STRING;
+    }
+
+    strbuf_clear(&json->strbuf);
+    while(text < end && *text == '\\') {
+        if(strbuf_strcpy(&json->strbuf, iter, text - iter))
+            return -1;
+
+        iter = json_escape(&json->strbuf, text, end);
+        if(!iter)
+            return -1;
+
+        text = json_string_end(iter, end);
+    }
+
+    if(text >= end || *text != '"')
+        return -1;
+
+    if(strbuf_strcpy(&json->strbuf, iter, text - iter))
+        return -1;
+
+    string = strbuf_string(&json->strbuf);
+    if(!string)
+        return -1;
+
+    json->view = *string;
+    json->iter = text + 1;
+
+    return JSON_STRING;
+}
+
+/*
+ * decode the escape at iter and return the end of it or NULL
+ */
+char * json_escape(struct strbuf * strbuf, char * iter, char * end) {
+    char c;
+
+    if(iter + 1 >= end)
+        return NULL;
+
+    switch(iter[1]) {
+        case '"': c = '"'; break;
+        case '\\': c = '\\'; break;
+        case '/': c = '/'; break;
+        case 'b': c = '\b'; break;
+        case 'f': c = '\f'; break;
+        case 'n': c = '\n'; break;
+        case 'r': c = '\r'; break;
+        case 't': c = '\t'; break;
+        case 'u': return json_unicode(strbuf, iter, end);
+        default: return NULL;
+    }
+
+    return strbuf_putc(strbuf, c) ? NULL : iter + 2;
+}
+
+/*
+ * a surrogate pair is joined, a lone surrogate is
+ * kept as is; the code point is written in utf-8
+ */
+char * json_unicode(struct strbuf * strbuf, char * iter, char * end) {
+    int status = 0;
+    unsigned int code;
+    unsigned int low;
+
+    if(json_hex(iter + 2, end, &code))
+        return NULL;
+
+    iter += 6;
+    if(code >= 0xD800 && code <= 0xDBFF && end - iter >= 6 && iter[0] == '\\' && iter[1] == 'u' &&
+       !json_hex(iter + 2, end, &low) && low >= 0xDC00 && low <= 0xDFFF) {
+        code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+        iter += 6;
+    }
+
+    if(code < 0x80) {
+        status = strbuf_putc(strbuf, code);
+    } else if(code < 0x800) {
+        status = strbuf_putc(strbuf, 0xC0 | code >> 6) ||
+                 strbuf_putc(strbuf, 0x80 | (code & 0x3F));
+    } else if(code < 0x10000) {
+        status = strbuf_putc(strbuf, 0xE0 | code >> 12) ||
+                 strbuf_putc(strbuf, 0x80 | (code >> 6 & 0x3F)) ||
+                 strbuf_putc(strbuf, 0x80 | (code & 0x3F));
+    } else {
+        status = strbuf_putc(strbuf, 0xF0 | code >> 18) ||
+                 strbuf_putc(strbuf, 0x80 | (code >> 12 & 0x3F)) ||
+                 strbuf_putc(strbuf, 0x80 | (code >> 6 & 0x3F)) ||
+                 strbuf_putc(strbuf, 0x80 | (code & 0x3F));
+    }
+
+    return status ? NULL : iter;
+}
+
+int json_hex(char * iter, char * end, unsigned int * value) {
+    int i;
+    char c;
+
+    if(end - iter < 4)
+        return 1;
+
+    *value = 0;
+    for(i = 0; i < 4; i++) {
+        c = iter[i];
+        if(c >= '0' && c <= '9') {
+            *value = *value << 4 | (c - '0');
+        } else if(c >= 'a' && c <= 'f') {
+            *value = *value << 4 | (c - 'a' + 10);
+        } else if(c >= 'A' && c <= 'F') {
+            *value = *value << 4 | (c - 'A' + 10);
+        } else {
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+char * json_digit(char * iter, char * end) {
+    while(iter < end && *iter >= '0' && *iter <= '9')
+        iter++;
+
+    return iter;
+}
+
+/*
+ * return the end of -?int frac? exp? at iter or NULL
+ */
+char * json_number_end(char * iter, char * end) {
+    char * next;
+
+    if(iter < end && *iter == '-')
+        iter++;
+
+    if(iter < end && *iter == '0') {
+        iter++;
+    } else {
+        next = json_digit(iter, end);
+        if(next == iter)
+            return NULL;
+        iter = next;
+    }
+
+    if(iter < end && *iter == '.') {
+        next = json_digit(iter + 1, end);
+        if(next == iter + 1)
+            return NULL;
+        iter = next;
+    }
+
+    if(iter < end && (*iter == 'e' || *iter == 'E')) {
+        iter++;
+        if(iter < end && (*iter == '+' || *iter == '-'))
+            iter++;
+        next = json_digit(iter, end);
+        if(next == iter)
+            return NULL;
+        iter = next;
+    }
+
+    return iter;
+}
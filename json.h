@@ -2,13 +2,20 @@
 #define json_h
 
 #include "event.h"
+#include "chunk.h"
 
 struct json {
     void * parser;
+    struct strbuf strbuf;
+    char * iter;
+    char * end;
+    struct string view;
     event_cb callback;
     void * context;
 };
 
-int json_parse(const char *, event_cb, void *);
+int json_create(struct json *, size_t);
+void json_destroy(struct json *);
+int json_chunk(struct json *, struct chunk *, event_cb, void *);
 
 #endif
@@ -1,13 +1,28 @@
 #include "logic.h"
 
+int logic_compare(void *, void *);
+int logic_term_compare(void *, void *);
+unsigned long logic_hash(enum logic_type, void *);
+int logic_index(struct logic *, void *, size_t *);
+
+struct logic_term * logic_term_create(struct logic *, struct logic_term *, struct logic_node *);
+void logic_term_free(struct logic_table *, struct logic_term *);
+void logic_term_release(struct logic *, struct logic_term *);
+struct logic_term * logic_term_and(struct logic *, struct logic_term *, enum logic_type, void *);
+int logic_term_drop(struct logic *, struct logic_term *, void *, struct logic_term **);
+
 struct logic_node * logic_node_create(struct logic *, enum logic_type, void *);
 void logic_node_destroy(struct logic *, struct logic_node *);
 struct logic_node * logic_node_copy(struct logic *, struct logic_node *);
 void logic_node_print(struct logic_node *, int);
 
-void logic_cond_insert(struct logic *, struct logic_node *, struct logic_node *);
-int logic_and_subset(struct logic_node *, struct logic_node *);
+int logic_list_subset(struct logic_node *, struct logic_node *);
+int logic_and_subset(struct logic_term *, struct logic_term *);
 void logic_and_insert(struct logic *, struct logic_node *, struct logic_node *);
+size_t logic_or_count(struct logic_node *);
+int logic_and_widen(struct logic *, struct logic_node *);
+int logic_or_widen(struct logic *, struct logic_node *);
+int logic_widen(struct logic *);
 
 int logic_and_cond(struct logic *, struct logic_node *, enum logic_type, void *);
 int logic_or_cond(struct logic *, struct logic_node *, enum logic_type, void *);
@@ -23,6 +38,319 @@ int logic_not(struct logic *, struct logic_node *);
 void logic_push_node(struct logic *, struct logic_node *);
 struct logic_node * logic_pop_node(struct logic *);
 
+int logic_compare(void * x, void * y) {
+    size_t l = (size_t) x;
+    size_t r = (size_t) y;
+    return l < r ? -1 : l > r ? 1 : 0;
+}
+
+int logic_term_compare(void * x, void * y) {
+    size_t i;
+    struct logic_term * l = x;
+    struct logic_term * r = y;
+    struct logic_node * p;
+    struct logic_node * q;
+
+    if(l->hash != r->hash)
+        return l->hash < r->hash ? -1 : 1;
+
+    if(l->exact != r->exact)
+        return l->exact < r->exact ? -1 : 1;
+
+    for(i = 0; i < LOGIC_WORD; i++) {
+        if(l->cond[i] != r->cond[i])
+            return l->cond[i] < r->cond[i] ? -1 : 1;
+        if(l->not_cond[i] != r->not_cond[i])
+            return l->not_cond[i] < r->not_cond[i] ? -1 : 1;
+    }
+
+    if(l->exact)
+        return 0;
+
+    p = l->root;
+    q = r->root;
+    while(p && q) {
+        if(p->data != q->data)
+            return p->data < q->data ? -1 : 1;
+        if(p->type != q->type)
+            return p->type < q->type ? -1 : 1;
+        p = p->next;
+        q = q->next;
+    }
+
+    return p ? 1 : q ? -1 : 0;
+}
+
+/*
+ * order independent, so a term's hash can be
+ * extended by one literal without a list walk
+ */
+unsigned long logic_hash(enum logic_type type, void * data) {
+    unsigned long hash;
+
+    hash = ((size_t) data >> 2) * 2 + (type == not_cond);
+    hash *= 2654435761UL;
+
+    return hash ^ (hash >> 15);
+}
+
+int logic_table_create(struct logic_table * table, struct pool * pool, struct pool * term_pool, struct pool * map_pool) {
+    int status = 0;
+
+    if(!pool || pool->size < sizeof(struct logic_node)) {
+        status = panic("invalid pool");
+    } else if(!term_pool || term_pool->size < sizeof(struct logic_term)) {
+        status = panic("invalid term pool");
+    } else if(map_create(&table->map, logic_compare, map_pool)) {
+        status = panic("failed to create map object");
+    } else {
+        if(map_create(&table->term, logic_term_compare, map_pool)) {
+            status = panic("failed to create map object");
+        } else {
+            table->pool = pool;
+            table->term_pool = term_pool;
+            table->count = 0;
+            table->term_widen = 0;
+            table->literal_widen = 0;
+        }
+        if(status)
+            map_destroy(&table->map);
+    }
+
+    return status;
+}
+
+void logic_table_destroy(struct logic_table * table) {
+    logic_table_clear(table);
+    map_destroy(&table->term);
+    map_destroy(&table->map);
+}
+
+void logic_table_clear(struct logic_table * table) {
+    struct map_kv kv;
+
+    kv = map_start(&table->term);
+    while(kv.key) {
+        logic_term_free(table, kv.key);
+        kv = map_next(&table->term);
+    }
+
+    map_clear(&table->term);
+    map_clear(&table->map);
+    table->count = 0;
+}
+
+void logic_table_print(struct logic_table * table) {
+    if(table->term_widen || table->literal_widen)
+        fprintf(stdout, "widen: %zu term %zu literal\n", table->term_widen, table->literal_widen);
+}
+
+int logic_index(struct logic * logic, void * data, size_t * result) {
+    int status = 0;
+    size_t index;
+    struct logic_table * table = logic->table;
+
+    index = (size_t) map_search(&table->map, data);
+    if(index) {
+        *result = index - 1;
+    } else if(map_insert(&table->map, data, (void *) (table->count + 1))) {
+        status = panic("failed to insert map object");
+    } else {
+        *result = table->count++;
+    }
+
+    return status;
+}
+
+/*
+ * create a term with the literals of root plus node;
+ * node is inserted in data order and owned by the term
+ */
+struct logic_term * logic_term_create(struct logic * logic, struct logic_term * root, struct logic_node * node) {
+    int status = 0;
+
+    struct logic_term * term;
+    struct logic_node * prev;
+    struct logic_node * iter;
+    struct logic_node * copy;
+
+    term = pool_get(logic->table->term_pool);
+    if(!term) {
+        status = panic("out of memory");
+    } else {
+        term->reference = 1;
+        term->count = root ? root->count + 1 : 1;
+        term->root = NULL;
+
+        prev = NULL;
+        iter = root ? root->root : NULL;
+        while((iter || node) && !status) {
+            if(node && (!iter || node->data < iter->data)) {
+                copy = node;
+                node = NULL;
+            } else {
+                copy = pool_get(logic->pool);
+                if(!copy) {
+                    status = panic("out of memory");
+                } else {
+                    *copy = *iter;
+                    iter = iter->next;
+                }
+            }
+            if(!status) {
+                copy->next = NULL;
+                if(prev) {
+                    prev->next = copy;
+                } else {
+                    term->root = copy;
+                }
+                prev = copy;
+            }
+        }
+
+        if(status) {
+            if(node)
+                pool_put(logic->pool, node);
+            logic_term_free(logic->table, term);
+        }
+    }
+
+    return status ? NULL : term;
+}
+
+void logic_term_free(struct logic_table * table, struct logic_term * term) {
+    struct logic_node * node;
+
+    while(term->root) {
+        node = term->root;
+        term->root = term->root->next;
+        pool_put(table->pool, node);
+    }
+
+    pool_put(table->term_pool, term);
+}
+
+void logic_term_release(struct logic * logic, struct logic_term * term) {
+    if(term && !--term->reference) {
+        map_delete(&logic->table->term, term);
+        logic_term_free(logic->table, term);
+    }
+}
+
+/*
+ * return the interned term of root and the literal;
+ * the caller owns one reference of the result
+ */
+struct logic_term * logic_term_and(struct logic * logic, struct logic_term * root, enum logic_type type, void * data) {
+    int status = 0;
+    size_t index;
+    unsigned long bit;
+    struct logic_term key;
+    struct logic_term * term = NULL;
+    struct logic_term * find;
+    struct logic_node * iter;
+    struct logic_node * node;
+
+    if(logic_index(logic, data, &index)) {
+        status = panic("failed to index logic object");
+    } else {
+        if(root) {
+            key = *root;
+        } else {
+            memset(&key, 0, sizeof(key));
+            key.exact = 1;
+        }
+
+        if(index < LOGIC_WORD * LOGIC_BIT) {
+            bit = 1UL << index % LOGIC_BIT;
+            if((key.cond[index / LOGIC_BIT] | key.not_cond[index / LOGIC_BIT]) & bit) {
+                term = root;
+            } else if(type == cond) {
+                key.cond[index / LOGIC_BIT] |= bit;
+            } else {
+                key.not_cond[index / LOGIC_BIT] |= bit;
+            }
+        } else {
+            iter = key.root;
+            while(iter && iter->data != data)
+                iter = iter->next;
+            if(iter)
+                term = root;
+            key.exact = 0;
+        }
+
+        if(term) {
+            term->reference++;
+        } else {
+            key.hash += logic_hash(type, data);
+            find = key.exact ? map_search(&logic->table->term, &key) : NULL;
+            if(find) {
+                term = find;
+                term->reference++;
+            } else {
+                node = logic_node_create(logic, type, data);
+                if(!node) {
+                    status = panic("failed to create logic node object");
+                } else {
+                    term = logic_term_create(logic, root, node);
+                    if(!term) {
+                        status = panic("failed to create logic term object");
+                    } else {
+                        term->hash = key.hash;
+                        term->exact = key.exact;
+                        memcpy(term->cond, key.cond, sizeof(term->cond));
+                        memcpy(term->not_cond, key.not_cond, sizeof(term->not_cond));
+
+                        find = key.exact ? NULL : map_search(&logic->table->term, term);
+                        if(find) {
+                            logic_term_free(logic->table, term);
+                            term = find;
+                            term->reference++;
+                        } else if(map_insert(&logic->table->term, term, term)) {
+                            status = panic("failed to insert map object");
+                            logic_term_free(logic->table, term);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    return status ? NULL : term;
+}
+
+/*
+ * return root without the literals of data
+ */
+int logic_term_drop(struct logic * logic, struct logic_term * root, void * data, struct logic_term ** result) {
+    int status = 0;
+    struct logic_term * term = NULL;
+    struct logic_term * next;
+    struct logic_node * iter;
+
+    iter = root ? root->root : NULL;
+    while(iter && !status) {
+        if(iter->data != data) {
+            next = logic_term_and(logic, term, iter->type, iter->data);
+            if(!next) {
+                status = panic("failed to and logic term object");
+            } else {
+                logic_term_release(logic, term);
+                term = next;
+            }
+        }
+        iter = iter->next;
+    }
+
+    if(status) {
+        logic_term_release(logic, term);
+    } else {
+        *result = term;
+    }
+
+    return status;
+}
+
 struct logic_node * logic_node_create(struct logic * logic, enum logic_type type, void * data) {
     struct logic_node * node;
 
@@ -30,6 +358,7 @@ struct logic_node * logic_node_create(struct logic * logic, enum logic_type type
     if(node) {
         node->type = type;
         node->data = data;
+        node->term = NULL;
         node->root = NULL;
         node->next = NULL;
     }
@@ -46,9 +375,13 @@ void logic_node_destroy(struct logic * logic, struct logic_node * root) {
         logic_node_destroy(logic, node);
     }
 
+    logic_term_release(logic, root->term);
     pool_put(logic->pool, root);
 }
 
+/*
+ * terms are immutable and shared by reference
+ */
 struct logic_node * logic_node_copy(struct logic * logic, struct logic_node * root) {
     int status = 0;
 
@@ -61,6 +394,10 @@ struct logic_node * logic_node_copy(struct logic * logic, struct logic_node * ro
     if(!node) {
         status = panic("failed to create logic node object");
     } else {
+        node->term = root->term;
+        if(node->term)
+            node->term->reference++;
+
         prev = NULL;
         iter = root->root;
         while(iter && !status) {
@@ -106,50 +443,53 @@ void logic_node_print(struct logic_node * root, int indent) {
         fprintf(stdout, "[and_or]\n");
     }
 
-    iter = root->root;
+    iter = root->term ? root->term->root : root->root;
     while(iter) {
         logic_node_print(iter, indent + 1);
         iter = iter->next;
     }
 }
 
-void logic_cond_insert(struct logic * logic, struct logic_node * root, struct logic_node * node) {
+int logic_list_subset(struct logic_node * root, struct logic_node * node) {
     struct logic_node * prev;
     struct logic_node * iter;
 
-    prev = NULL;
-    iter = root->root;
-    while(iter && iter->data <= node->data) {
-        prev = iter;
-        iter = iter->next;
+    prev = root;
+    iter = node;
+    while(prev && iter) {
+        if(prev->data < iter->data) {
+            prev = prev->next;
+        } else if(prev->data == iter->data && prev->type == iter->type) {
+            prev = prev->next;
+            iter = iter->next;
+        } else {
+            break;
+        }
     }
 
-    if(!prev) {
-        node->next = root->root;
-        root->root = node;
-    } else if(prev->data == node->data) {
-        logic_node_destroy(logic, node);
-    } else {
-        node->next = prev->next;
-        prev->next = node;
-    }
+    return iter ? 1 : 0;
 }
 
-int logic_and_subset(struct logic_node * root, struct logic_node * node) {
-    struct logic_node * prev;
-    struct logic_node * iter;
+/*
+ * return zero if every literal of node is in root
+ */
+int logic_and_subset(struct logic_term * root, struct logic_term * node) {
+    size_t i;
+    unsigned long bits = 0;
 
-    prev = root->root;
-    while(prev && prev->data < node->data)
-        prev = prev->next;
+    if(root == node || !node)
+        return 0;
 
-    iter = node->root;
-    while(prev && iter && prev->data == iter->data && prev->type == iter->type) {
-        prev = prev->next;
-        iter = iter->next;
-    }
+    if(!root)
+        return 1;
 
-    return iter ? 1 : 0;
+    if(!root->exact || !node->exact)
+        return logic_list_subset(root->root, node->root);
+
+    for(i = 0; i < LOGIC_WORD; i++)
+        bits |= (node->cond[i] & ~root->cond[i]) | (node->not_cond[i] & ~root->not_cond[i]);
+
+    return bits ? 1 : 0;
 }
 
 void logic_and_insert(struct logic * logic, struct logic_node * root, struct logic_node * node) {
@@ -157,7 +497,7 @@ void logic_and_insert(struct logic * logic, struct logic_node * root, struct log
     struct logic_node * iter;
 
     iter = root->root;
-    while(iter && logic_and_subset(node, iter))
+    while(iter && logic_and_subset(node->term, iter->term))
         iter = iter->next;
 
     if(iter) {
@@ -167,7 +507,7 @@ void logic_and_insert(struct logic * logic, struct logic_node * root, struct log
         while(root->root) {
             iter = root->root;
             root->root = root->root->next;
-            if(logic_and_subset(iter, node)) {
+            if(logic_and_subset(iter->term, node->term)) {
                 prev = prev->next = iter;
             } else {
                 logic_node_destroy(logic, iter);
@@ -178,15 +518,171 @@ void logic_and_insert(struct logic * logic, struct logic_node * root, struct log
     }
 }
 
-int logic_and_cond(struct logic * logic, struct logic_node * root, enum logic_type type, void * data) {
+size_t logic_or_count(struct logic_node * root) {
+    size_t count = 0;
+    struct logic_node * iter;
+
+    iter = root->root;
+    while(iter) {
+        count++;
+        iter = iter->next;
+    }
+
+    return count;
+}
+
+/*
+ * drop the most recently indexed conditions until the term
+ * is within the limit
+ */
+int logic_and_widen(struct logic * logic, struct logic_node * root) {
+    int status = 0;
+    size_t index;
+    size_t last;
+    void * drop;
+    struct logic_node * iter;
+    struct logic_term * term;
+
+    while(!status && logic->literal_limit && root->term && root->term->count > logic->literal_limit) {
+        drop = NULL;
+        last = 0;
+
+        iter = root->term->root;
+        while(iter) {
+            index = (size_t) map_search(&logic->table->map, iter->data);
+            if(index >= last) {
+                last = index;
+                drop = iter->data;
+            }
+            iter = iter->next;
+        }
+
+        if(logic_term_drop(logic, root->term, drop, &term)) {
+            status = panic("failed to drop logic term object");
+        } else {
+            logic_term_release(logic, root->term);
+            root->term = term;
+            logic->table->literal_widen++;
+        }
+    }
+
+    return status;
+}
+
+/*
+ * drop the condition shared by the most terms until the term
+ * count is within the limit; each term only gets more general
+ */
+int logic_or_widen(struct logic * logic, struct logic_node * root) {
     int status = 0;
+    size_t i;
+    size_t index;
+    size_t count[LOGIC_WORD * LOGIC_BIT];
+    void * data[LOGIC_WORD * LOGIC_BIT];
+    void * drop;
+    struct logic_node * iter;
     struct logic_node * node;
+    struct logic_term * term;
 
-    node = logic_node_create(logic, type, data);
-    if(!node) {
-        status = panic("failed to create logic node object");
+    while(!status && logic->term_limit && logic_or_count(root) > logic->term_limit) {
+        memset(count, 0, sizeof(count));
+        drop = NULL;
+
+        iter = root->root;
+        while(iter) {
+            node = iter->term ? iter->term->root : NULL;
+            while(node) {
+                index = (size_t) map_search(&logic->table->map, node->data);
+                if(index && index <= LOGIC_WORD * LOGIC_BIT) {
+                    count[index - 1]++;
+                    data[index - 1] = node->data;
+                } else if(!drop) {
+                    drop = node->data;
+                }
+                node = node->next;
+            }
+            iter = iter->next;
+        }
+
+        index = 0;
+        for(i = 1; i < LOGIC_WORD * LOGIC_BIT; i++)
+            if(count[i] > count[index])
+                index = i;
+        if(count[index])
+            drop = data[index];
+
+        iter = root->root;
+        root->root = NULL;
+        while(iter) {
+            node = iter;
+            iter = iter->next;
+            node->next = NULL;
+            if(status) {
+                logic_node_destroy(logic, node);
+            } else if(logic_and_widen(logic, node)) {
+                status = panic("failed to widen logic node object");
+                logic_node_destroy(logic, node);
+            } else if(logic_term_drop(logic, node->term, drop, &term)) {
+                status = panic("failed to drop logic term object");
+                logic_node_destroy(logic, node);
+            } else {
+                logic_term_release(logic, node->term);
+                node->term = term;
+                logic_and_insert(logic, root, node);
+            }
+        }
+
+        logic->table->term_widen++;
+    }
+
+    return status;
+}
+
+/*
+ * widen the top node unless a not node below it will negate
+ * it later; weakening a negated formula strengthens the result
+ */
+int logic_widen(struct logic * logic) {
+    int status = 0;
+    struct logic_node * root;
+    struct logic_node * iter;
+
+    root = logic->root;
+    iter = root ? root->next : NULL;
+    while(iter && iter->type != not)
+        iter = iter->next;
+
+    if(root && !iter) {
+        if(root->type == and || root->type == not) {
+            if(logic_and_widen(logic, root))
+                status = panic("failed to widen logic node object");
+        } else if(root->type == or || root->type == and_or) {
+            iter = root->root;
+            while(iter && !status) {
+                if(logic_and_widen(logic, iter)) {
+                    status = panic("failed to widen logic node object");
+                } else {
+                    iter = iter->next;
+                }
+            }
+            if(!status && logic_or_widen(logic, root))
+                status = panic("failed to widen logic node object");
+        }
+    }
+
+    return status;
+}
+
+int logic_and_cond(struct logic * logic, struct logic_node * root, enum logic_type type, void * data) {
+    int status = 0;
+    struct logic_term * term;
+
+    term = logic_term_and(logic, root->term, type, data);
+    if(!term) {
+        status = panic("failed to and logic term object");
     } else {
-        logic_cond_insert(logic, root, node);
+        logic_term_release(logic, root->term);
+        root->term = term;
     }
 
     return status;
@@ -238,7 +734,7 @@ struct logic_node * logic_and_and(struct logic * logic, struct logic_node * root
     if(!leaf) {
         status = panic("failed to copy logic node object");
     } else {
-        iter = node->root;
+        iter = node->term && node->term != root->term ? node->term->root : NULL;
         while(iter && !status) {
             if(logic_and_cond(logic, leaf, iter->type, iter->data)) {
                 status = panic("failed to and cond logic object");
@@ -263,7 +759,7 @@ struct logic_node * logic_and_and_or(struct logic * logic, struct logic_node * r
     if(!leaf) {
         status = panic("failed to copy logic node object");
     } else {
-        iter = root->root;
+        iter = root->term ? root->term->root : NULL;
         while(iter && !status) {
             if(logic_and_or_cond(logic, leaf, iter->type, iter->data)) {
                 status = panic("failed to and cond logic object");
@@ -378,7 +874,7 @@ int logic_not(struct logic * logic, struct logic_node * root) {
         if(logic_push(logic, or, NULL)) {
             status = panic("failed to push logic object");
         } else {
-            iter = root->root;
+            iter = root->term ? root->term->root : NULL;
             while(iter && !status) {
                 if(logic_not(logic, iter)) {
                     status = panic("failed to not logic object");
@@ -412,14 +908,17 @@ struct logic_node * logic_pop_node(struct logic * logic) {
     return node;
 }
 
-int logic_create(struct logic * logic, struct pool * pool) {
+int logic_create(struct logic * logic, struct logic_table * table) {
     int status = 0;
 
-    if(!pool || pool->size < sizeof(struct logic_node)) {
-        status = panic("invalid pool");
+    if(!table) {
+        status = panic("invalid table");
     } else {
-        logic->pool = pool;
+        logic->table = table;
+        logic->pool = table->pool;
         logic->root = NULL;
+        logic->term_limit = LOGIC_TERM_LIMIT;
+        logic->literal_limit = LOGIC_LITERAL_LIMIT;
     }
 
     return status;
@@ -442,9 +941,12 @@ int logic_copy(struct logic * result, struct logic * logic) {
     struct logic_node * iter;
     struct logic_node * copy;
 
-    if(logic_create(result, logic->pool)) {
+    if(logic_create(result, logic->table)) {
         status = panic("failed to create logic object");
     } else {
+        result->term_limit = logic->term_limit;
+        result->literal_limit = logic->literal_limit;
+
         prev = NULL;
         iter = logic->root;
         while(iter && !status) {
@@ -517,7 +1019,7 @@ int logic_pop(struct logic * logic) {
     if(!node) {
         status = panic("failed to pop logic node object");
     } else {
-        if(node->root) {
+        if(node->root || node->term) {
             root = logic_pop_node(logic);
             if(!root) {
                 status = panic("failed to pop logic node object");
@@ -587,7 +1089,7 @@ int logic_pop(struct logic * logic) {
                         if(logic_push(logic, or, NULL)) {
                             status = panic("failed to push logic object");
                         } else {
-                            leaf = node->root;
+                            leaf = node->term->root;
                             while(leaf && !status) {
                                 if(logic_not(logic, leaf)) {
                                     status = panic("failed to not logic object");
@@ -619,6 +1121,9 @@ int logic_pop(struct logic * logic) {
             }
         }
         logic_node_destroy(logic, node);
+
+        if(!status && logic_widen(logic))
+            status = panic("failed to widen logic object");
     }
 
     return status;
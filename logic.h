@@ -1,7 +1,18 @@
 #ifndef logic_h
 #define logic_h
 
-#include "pool.h"
+#include "map.h"
+
+#define LOGIC_WORD 4
+#define LOGIC_BIT (sizeof(unsigned long) * 8)
+
+#ifndef LOGIC_TERM_LIMIT
+#define LOGIC_TERM_LIMIT 64
+#endif
+
+#ifndef LOGIC_LITERAL_LIMIT
+#define LOGIC_LITERAL_LIMIT 16
+#endif
 
 enum logic_type {
     cond,
@@ -12,19 +23,67 @@ enum logic_type {
     not
 };
 
+/*
+ * condition dictionary and term set shared by every
+ * logic object of a compile; a condition's index
+ * selects its bit in the term signature
+ */
+struct logic_table {
+    struct pool * pool;
+    struct pool * term_pool;
+    struct map map;
+    struct map term;
+    size_t count;
+    size_t term_widen;
+    size_t literal_widen;
+};
+
+int logic_table_create(struct logic_table *, struct pool *, struct pool *, struct pool *);
+void logic_table_destroy(struct logic_table *);
+void logic_table_clear(struct logic_table *);
+void logic_table_print(struct logic_table *);
+
+struct logic_node;
+
+/*
+ * immutable conjunction of cond and not_cond nodes;
+ * equal terms are interned to the same object
+ */
+struct logic_term {
+    size_t reference;
+    unsigned long hash;
+    int exact;
+    unsigned long cond[LOGIC_WORD];
+    unsigned long not_cond[LOGIC_WORD];
+    size_t count;
+    struct logic_node * root;
+};
+
+/*
+ * the cells of an or/and_or list belong to one node and
+ * are copied with it, only their terms are shared
+ */
 struct logic_node {
     enum logic_type type;
     void * data;
+    struct logic_term * term;
     struct logic_node * root;
     struct logic_node * next;
 };
 
+/*
+ * or/and_or nodes over term_limit terms and terms over
+ * literal_limit literals are widened; zero is no limit
+ */
 struct logic {
+    struct logic_table * table;
     struct pool * pool;
     struct logic_node * root;
+    size_t term_limit;
+    size_t literal_limit;
 };
 
-int logic_create(struct logic *, struct pool *);
+int logic_create(struct logic *, struct logic_table *);
 void logic_destroy(struct logic *);
 int logic_copy(struct logic *, struct logic *);
 int logic_push(struct logic *, enum logic_type, void *);
@@ -104,6 +104,8 @@ static inline void map_insert_node(struct map * map, struct map_node * x) {
         while(i) {
             p = i;
             c = map->compare(x->key, p->key);
+            if(!c)
+                break;
             i = 0 > c ? i->left : i->right;
         }
 
@@ -357,6 +359,20 @@ int map_copy(struct map * result, struct map * map) {
     return status;
 }
 
+int map_merge(struct map * map, struct map * from) {
+    int status = 0;
+    struct map_kv kv;
+
+    kv = map_start(from);
+    while(kv.key && !status) {
+        if(map_insert(map, kv.key, kv.value))
+            status = panic("failed to insert map object");
+        kv = map_next(from);
+    }
+
+    return status;
+}
+
 int map_insert(struct map * map, void * key, void * value) {
     int status = 0;
     struct map_node * node;
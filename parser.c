@@ -2,35 +2,43 @@
 
 struct schema_node * schema_node_create(struct schema *, enum schema_type, int);
 void schema_node_destroy(struct schema *, struct schema_node *);
-void schema_node_print(struct schema_node *, int, char *);
+void schema_node_print(struct schema_node *, int, struct string *);
 
 void schema_clear(struct schema *);
 int schema_reset(struct schema *);
 
-struct schema_node * schema_add(struct schema *, struct schema_node *, enum schema_type, int, char *);
-struct schema_node * schema_get(struct schema_node *, char *);
+int schema_compare(struct string *, struct string *);
+struct string * schema_key(struct string *, char *);
+struct schema_node * schema_add(struct schema *, struct schema_node *, enum schema_type, int, struct string *);
+struct schema_node * schema_get(struct schema_node *, struct string *);
 
 struct schema_state {
     struct schema * schema;
     struct schema_node * root;
     struct strbuf * strbuf;
-    char * key;
+    struct string * key;
 };
 
 int schema_state_parse(enum event_type, struct string *, void *);
-int schema_state_node(struct schema_state *, enum event_type, char *);
+int schema_state_node(struct schema_state *, enum event_type, struct string *);
 
 struct data_state {
+    struct schema * schema;
     struct schema_node * root;
     struct schema_node * data;
+    size_t skip;
     parser_cb callback;
     void * context;
 };
 
 int data_state_parse(enum event_type, struct string *, void *);
+void data_state_skip(struct data_state *, enum event_type);
 int data_state_node(struct data_state *, struct schema_node *, enum event_type, struct string *);
+struct schema_node * data_state_get(struct data_state *, struct string *);
+int data_state_type(struct data_state *, struct schema_node *, enum schema_type);
 
 int parser_parse(struct parser *, const char *, event_cb, void *);
+int parser_markup(struct parser *, struct schema_markup *);
 
 struct schema_node * schema_node_create(struct schema * schema, enum schema_type type, int mark) {
     int status = 0;
@@ -42,7 +50,7 @@ struct schema_node * schema_node_create(struct schema * schema, enum schema_type
     } else {
         node->type = type;
         node->mark = mark;
-        if(map_create(&node->map, (map_compare_cb) strcmp, &schema->pool))
+        if(map_create(&node->map, (map_compare_cb) schema_compare, &schema->pool))
             status = panic("failed to create map object");
     }
 
@@ -64,7 +72,7 @@ void schema_node_destroy(struct schema * schema, struct schema_node * node) {
     map_destroy(&node->map);
 }
 
-void schema_node_print(struct schema_node * node, int indent, char * key) {
+void schema_node_print(struct schema_node * node, int indent, struct string * key) {
     int i;
     struct map_kv kv;
 
@@ -72,9 +80,9 @@ void schema_node_print(struct schema_node * node, int indent, char * key) {
         fputs("  ", stdout);
 
     if(key)
-        fprintf(stdout, "[%s]", key);
+        fprintf(stdout, "[%s]", key->string);
 
-    switch(node->type) {
+    switch(node->type & (schema_list | schema_map | schema_string)) {
         case schema_list | schema_map | schema_string:
             fprintf(stdout, "[list | map | string]");
             break;
@@ -165,9 +173,31 @@ void schema_print(struct schema * schema) {
         schema_node_print(schema->root, 0, NULL);
 }
 
-struct schema_node * schema_add(struct schema * schema, struct schema_node * root, enum schema_type type, int mark, char * key) {
+/*
+ * keys are matched by length before memcmp,
+ * so the key of a lookup need not be terminated
+ */
+int schema_compare(struct string * x, struct string * y) {
+    if(x->length != y->length)
+        return x->length < y->length ? -1 : 1;
+
+    return memcmp(x->string, y->string, x->length);
+}
+
+struct string * schema_key(struct string * string, char * key) {
+    if(!key)
+        return NULL;
+
+    string->length = strlen(key);
+    string->string = key;
+
+    return string;
+}
+
+struct schema_node * schema_add(struct schema * schema, struct schema_node * root, enum schema_type type, int mark, struct string * key) {
     int status = 0;
     struct schema_node * node;
+    struct string * string;
 
     if(key) {
         if(root->type & schema_map) {
@@ -179,11 +209,17 @@ struct schema_node * schema_add(struct schema * schema, struct schema_node * roo
                 if(!node) {
                     status = panic("failed to create schema node object");
                 } else {
-                    key = store_strcpy(&schema->store, key, strlen(key));
-                    if(!key) {
-                        status = panic("failed to strcpy store object");
-                    } else if(map_insert(&root->map, key, node)) {
-                        status = panic("failed to insert map object");
+                    string = store_malloc(&schema->store, sizeof(*string));
+                    if(!string) {
+                        status = panic("failed to malloc store object");
+                    } else {
+                        string->length = key->length;
+                        string->string = store_strcpy(&schema->store, key->string, key->length);
+                        if(!string->string) {
+                            status = panic("failed to strcpy store object");
+                        } else if(map_insert(&root->map, string, node)) {
+                            status = panic("failed to insert map object");
+                        }
                     }
                     if(status)
                         schema_node_destroy(schema, node);
@@ -213,7 +249,7 @@ struct schema_node * schema_add(struct schema * schema, struct schema_node * roo
     return status ? NULL : node;
 }
 
-struct schema_node * schema_get(struct schema_node * root, char * key) {
+struct schema_node * schema_get(struct schema_node * root, struct string * key) {
     int status = 0;
     struct schema_node * node;
 
@@ -221,7 +257,7 @@ struct schema_node * schema_get(struct schema_node * root, char * key) {
         if(root->type & schema_map) {
             node = map_search(&root->map, key);
             if(!node)
-                status = panic("invalid key - %s", key);
+                status = panic("invalid key - %.*s", (int) key->length, key->string);
         } else {
             status = panic("expected map");
         }
@@ -242,6 +278,7 @@ int schema_reload(struct schema * schema, struct schema_markup * array) {
     int status = 0;
     struct schema_node * node;
     struct schema_node * root;
+    struct string key;
 
     if(schema_reset(schema)) {
         status = panic("failed to reset schema object");
@@ -256,7 +293,7 @@ int schema_reload(struct schema * schema, struct schema_markup * array) {
                 while(root->state >= array->level)
                     root = root->next;
 
-                node = schema_add(schema, root, array->type, array->mark, array->key);
+                node = schema_add(schema, root, array->type, array->mark, schema_key(&key, array->key));
                 if(!node) {
                     status = panic("failed to add schema object");
                 } else {
@@ -279,6 +316,7 @@ int schema_update(struct schema * schema, struct schema_markup * array) {
     int status = 0;
     struct schema_node * node;
     struct schema_node * root;
+    struct string key;
 
     root = schema->root;
     if(!root) {
@@ -290,7 +328,7 @@ int schema_update(struct schema * schema, struct schema_markup * array) {
             while(root->state >= array->level)
                 root = root->next;
 
-            node = schema_get(root, array->key);
+            node = schema_get(root, schema_key(&key, array->key));
             if(!node) {
                 status = panic("failed to get schema object");
             } else {
@@ -346,9 +384,9 @@ int schema_state_parse(enum event_type type, struct string * string, void * cont
             if(strbuf_strcpy(state->strbuf, string->string, string->length)) {
                 status = panic("failed to strcpy strbuf object");
             } else {
-                state->key = strbuf_array(state->strbuf);
+                state->key = strbuf_string(state->strbuf);
                 if(!state->key)
-                    status = panic("failed to array strbuf object");
+                    status = panic("failed to string strbuf object");
             }
         } else if(type == event_map_end) {
             state->root = state->root->next;
@@ -362,7 +400,7 @@ int schema_state_parse(enum event_type type, struct string * string, void * cont
     return status;
 }
 
-int schema_state_node(struct schema_state * state, enum event_type type, char * key) {
+int schema_state_node(struct schema_state * state, enum event_type type, struct string * key) {
     int status = 0;
     struct schema_node * node;
 
@@ -395,6 +433,11 @@ int schema_state_node(struct schema_state * state, enum event_type type, char *
     return status;
 }
 
+/*
+ * every table is read through the events of its scanner;
+ * each key is looked up in the schema and each value is
+ * passed to the callback of the table with its mark
+ */
 int data_state_parse(enum event_type type, struct string * string, void * context) {
     int status = 0;
 
@@ -403,7 +446,9 @@ int data_state_parse(enum event_type type, struct string * string, void * contex
 
     state = context;
 
-    if(state->root->state == schema_list) {
+    if(state->skip) {
+        data_state_skip(state, type);
+    } else if(state->root->state == schema_list) {
         if(type == event_list_end) {
             if(state->callback(parser_end, state->root->mark, NULL, state->context)) {
                 status = panic("failed to process end event");
@@ -411,7 +456,7 @@ int data_state_parse(enum event_type type, struct string * string, void * contex
                 state->root = state->root->next;
             }
         } else {
-            node = schema_get(state->root, NULL);
+            node = data_state_get(state, NULL);
             if(!node) {
                 status = panic("failed to get schema object");
             } else if(data_state_node(state, node, type, string)) {
@@ -426,11 +471,15 @@ int data_state_parse(enum event_type type, struct string * string, void * contex
                 state->data = NULL;
             }
         } else if(type == event_scalar) {
-            node = schema_get(state->root, string->string);
-            if(!node) {
-                status = panic("failed to get schema object");
+            if(!state->schema && state->root->type & schema_skip && !map_search(&state->root->map, string)) {
+                state->skip = 1;
             } else {
-                state->data = node;
+                node = data_state_get(state, string);
+                if(!node) {
+                    status = panic("failed to get schema object");
+                } else {
+                    state->data = node;
+                }
             }
         } else if(type == event_map_end) {
             if(state->callback(parser_end, state->root->mark, NULL, state->context)) {
@@ -448,11 +497,26 @@ int data_state_parse(enum event_type type, struct string * string, void * contex
     return status;
 }
 
+/*
+ * skip the value of a key that a schema_skip map does not
+ * have; skip is one more than the depth into the value
+ */
+void data_state_skip(struct data_state * state, enum event_type type) {
+    if(type == event_list_start || type == event_map_start) {
+        state->skip++;
+    } else if(type == event_list_end || type == event_map_end) {
+        state->skip--;
+    }
+
+    if(state->skip == 1)
+        state->skip = 0;
+}
+
 int data_state_node(struct data_state * state, struct schema_node * node, enum event_type type, struct string * string) {
     int status = 0;
 
     if(type == event_list_start) {
-        if(node->type & schema_list) {
+        if(data_state_type(state, node, schema_list)) {
             if(state->callback(parser_start, node->mark, NULL, state->context)) {
                 status = panic("failed to process start event");
             } else {
@@ -464,7 +528,7 @@ int data_state_node(struct data_state * state, struct schema_node * node, enum e
             status = panic("unexpected list");
         }
     } else if(type == event_map_start) {
-        if(node->type & schema_map) {
+        if(data_state_type(state, node, schema_map)) {
             if(state->callback(parser_start, node->mark, NULL, state->context)) {
                 status = panic("failed to process start event");
             } else {
@@ -476,7 +540,7 @@ int data_state_node(struct data_state * state, struct schema_node * node, enum e
             status = panic("unexpected map");
         }
     } else if(type == event_scalar) {
-        if(node->type & schema_string) {
+        if(data_state_type(state, node, schema_string)) {
             if(state->callback(parser_next, node->mark, string, state->context))
                 status = panic("failed to process next event");
         } else {
@@ -489,17 +553,40 @@ int data_state_node(struct data_state * state, struct schema_node * node, enum e
     return status;
 }
 
+/*
+ * with a schema, a key or list entry that the markup does
+ * not have is added unmarked instead of failing the parse
+ */
+struct schema_node * data_state_get(struct data_state * state, struct string * key) {
+    if(state->schema)
+        return schema_add(state->schema, state->root, 0, 0, key);
+
+    return schema_get(state->root, key);
+}
+
+int data_state_type(struct data_state * state, struct schema_node * node, enum schema_type type) {
+    if(state->schema && !node->mark)
+        node->type |= type;
+
+    return node->type & type;
+}
+
 int parser_create(struct parser * parser, size_t size) {
     int status = 0;
 
-    if(yaml_create(&parser->yaml, size)) {
+    if(json_create(&parser->json, size)) {
+        status = panic("failed to create json object");
+    } else if(yaml_create(&parser->yaml, size)) {
         status = panic("failed to create yaml object");
+        goto yaml_fail;
     } else if(strbuf_create(&parser->strbuf, size)) {
         status = panic("failed to create strbuf object");
         goto strbuf_fail;
     } else if(schema_create(&parser->schema, size)) {
         status = panic("failed to create schema object");
         goto schema_fail;
+    } else {
+        parser->markup = NULL;
     }
 
     return status;
@@ -508,6 +595,8 @@ schema_fail:
     strbuf_destroy(&parser->strbuf);
 strbuf_fail:
     yaml_destroy(&parser->yaml);
+yaml_fail:
+    json_destroy(&parser->json);
 
     return status;
 }
@@ -516,6 +605,7 @@ void parser_destroy(struct parser * parser) {
     schema_destroy(&parser->schema);
     strbuf_destroy(&parser->strbuf);
     yaml_destroy(&parser->yaml);
+    json_destroy(&parser->json);
 }
 
 int parser_schema_parse(struct parser * parser, struct schema * schema, const char * path) {
@@ -523,6 +613,9 @@ int parser_schema_parse(struct parser * parser, struct schema * schema, const ch
 
     struct schema_state state;
 
+    if(schema == &parser->schema)
+        parser->markup = NULL;
+
     if(schema_reset(schema)) {
         status = panic("failed to reset schema object");
     } else {
@@ -549,8 +642,10 @@ int parser_data_parse(struct parser * parser, struct schema * schema, const char
 
     struct data_state state;
 
+    state.schema = NULL;
     state.root = schema->root;
     state.data = NULL;
+    state.skip = 0;
     state.callback = callback;
     state.context = context;
 
@@ -566,24 +661,62 @@ int parser_data_parse(struct parser * parser, struct schema * schema, const char
     return status;
 }
 
+/*
+ * the whole input is read into memory, a pipe included, so
+ * plain scalars can be passed as views into the buffer; the
+ * format is taken from the extension of a path and an input
+ * without one is json if it starts with [ or { and yaml if not
+ */
 int parser_parse(struct parser * parser, const char * path, event_cb callback, void * context) {
     int status = 0;
 
     char * ext;
+    char * iter;
+    struct chunk chunk;
 
-    ext = strrchr(path, '.');
-    if(!ext) {
-        status = panic("failed to get file extension - %s", path);
+    if(chunk_map(&chunk, path)) {
+        status = panic("failed to map chunk object");
     } else {
+        ext = strrchr(path, '.');
+        if(!ext) {
+            iter = chunk.begin;
+            while(iter < chunk.end && isspace(*iter))
+                iter++;
+
+            ext = (iter < chunk.end && (*iter == '[' || *iter == '{')) ? ".json" : ".yml";
+        }
+
         if(!strcmp(ext, ".json")) {
-            if(json_parse(path, callback, context))
-                status = panic("failed to parse json object");
+            if(json_chunk(&parser->json, &chunk, callback, context))
+                status = panic("failed to parse %s", path);
         } else if(!strcmp(ext, ".yaml") || !strcmp(ext, ".yml")) {
-            if(yaml_parse(&parser->yaml, path, callback, context))
-                status = panic("failed to parse yaml object");
+            if(yaml_chunk(&parser->yaml, &chunk, callback, context))
+                status = panic("failed to parse %s", path);
         } else {
             status = panic("unsupported extension - %s", ext);
         }
+
+        chunk_unmap(&chunk);
+    }
+
+    return status;
+}
+
+/*
+ * the schema of a markup is built once and kept while
+ * the next files use the same markup
+ */
+int parser_markup(struct parser * parser, struct schema_markup * markup) {
+    int status = 0;
+
+    if(parser->markup != markup) {
+        parser->markup = NULL;
+
+        if(schema_reload(&parser->schema, markup)) {
+            status = panic("failed to reload schema object");
+        } else {
+            parser->markup = markup;
+        }
     }
 
     return status;
@@ -592,7 +725,7 @@ int parser_parse(struct parser * parser, const char * path, event_cb callback, v
 int parser_file(struct parser * parser, struct schema_markup * markup, const char * path, parser_cb callback, void * context) {
     int status = 0;
 
-    if(schema_reload(&parser->schema, markup)) {
+    if(parser_markup(parser, markup)) {
         status = panic("failed to load schema object");
     } else if(parser_data_parse(parser, &parser->schema, path, callback, context)) {
         status = panic("failed to data parse parser object");
@@ -601,15 +734,63 @@ int parser_file(struct parser * parser, struct schema_markup * markup, const cha
     return status;
 }
 
+/*
+ * parse a file whose schema is only partly known in one
+ * pass, the rest of the schema is added as it is read
+ */
 int parser_file2(struct parser * parser, struct schema_markup * markup, const char * path, parser_cb callback, void * context) {
     int status = 0;
 
-    if(parser_schema_parse(parser, &parser->schema, path)) {
-        status = panic("failed to schema parse parser object");
-    } else if(schema_update(&parser->schema, markup)) {
-        status = panic("failed to mark schema object");
-    } else if(parser_data_parse(parser, &parser->schema, path, callback, context)) {
-        status = panic("failed to data parse parser object");
+    struct data_state state;
+
+    parser->markup = NULL;
+
+    if(schema_reload(&parser->schema, markup)) {
+        status = panic("failed to load schema object");
+    } else {
+        state.schema = &parser->schema;
+        state.root = parser->schema.root;
+        state.data = NULL;
+        state.skip = 0;
+        state.callback = callback;
+        state.context = context;
+
+        if(!state.root) {
+            status = panic("invalid node");
+        } else {
+            state.root->state = schema_list;
+
+            if(parser_parse(parser, path, data_state_parse, &state))
+                status = panic("failed to parse parser object");
+        }
+    }
+
+    return status;
+}
+
+int parser_chunk(struct parser * parser, struct schema_markup * markup, struct chunk * chunk, parser_cb callback, void * context) {
+    int status = 0;
+
+    struct data_state state;
+
+    if(parser_markup(parser, markup)) {
+        status = panic("failed to load schema object");
+    } else {
+        state.schema = NULL;
+        state.root = parser->schema.root;
+        state.data = NULL;
+        state.skip = 0;
+        state.callback = callback;
+        state.context = context;
+
+        if(!state.root) {
+            status = panic("invalid node");
+        } else {
+            state.root->state = schema_list;
+
+            if(yaml_chunk(&parser->yaml, chunk, data_state_parse, &state))
+                status = panic("failed to parse yaml object");
+        }
     }
 
     return status;
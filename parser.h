@@ -9,7 +9,8 @@
 enum schema_type {
     schema_list = 0x1,
     schema_map = 0x2,
-    schema_string = 0x4
+    schema_string = 0x4,
+    schema_skip = 0x8
 };
 
 struct schema_node {
@@ -42,9 +43,11 @@ int schema_reload(struct schema *, struct schema_markup *);
 int schema_update(struct schema *, struct schema_markup *);
 
 struct parser {
+    struct json json;
     struct yaml yaml;
     struct strbuf strbuf;
     struct schema schema;
+    struct schema_markup * markup;
 };
 
 int parser_create(struct parser *, size_t);
@@ -53,5 +56,6 @@ int parser_schema_parse(struct parser *, struct schema *, const char *);
 int parser_data_parse(struct parser *, struct schema *, const char *, parser_cb, void *);
 int parser_file(struct parser *, struct schema_markup *, const char *, parser_cb, void *);
 int parser_file2(struct parser *, struct schema_markup *, const char *, parser_cb, void *);
+int parser_chunk(struct parser *, struct schema_markup *, struct chunk *, parser_cb, void *);
 
 #endif
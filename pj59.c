@@ -1,6 +1,60 @@
 #include "unistd.h"
+#include "getopt.h"
 #include "script.h"
 
+/*
+ * every table can be read from another path with --<table> <path>,
+ * "-" is the standard input and "fd:N" is descriptor N; paths are
+ * relative to the directory given as the first argument and each
+ * table is only read once the items need it; the csv tables and
+ * constant.yml are read from a pipe in bounded batches, the other
+ * yaml and json tables are read to the end into memory first. the
+ * item_db format is taken from the extension, so an item_db.yml has
+ * to be given as a .yml or .yaml path and not as - or fd:N
+ */
+char * input[] = {
+    [table_item] = "item_db.txt",
+    [table_item_combo] = "item_combo_db.txt",
+    [table_skill] = "skill_db.yml",
+    [table_mob] = "mob_db.txt",
+    [table_mercenary] = "mercenary_db.txt",
+    [table_constant] = "constant.yml",
+    [table_constant_data] = "constant_data.yml",
+    [table_constant_group] = "constant_group.yml",
+    [table_argument] = "argument.yml",
+    [table_bonus] = "bonus.yml",
+    [table_bonus2] = "bonus2.yml",
+    [table_bonus3] = "bonus3.yml",
+    [table_bonus4] = "bonus4.yml",
+    [table_bonus5] = "bonus5.yml",
+    [table_sc_start] = "sc_start.yml",
+    [table_sc_start2] = "sc_start2.yml",
+    [table_sc_start4] = "sc_start4.yml",
+    [table_statement] = "statement.yml"
+};
+
+struct option option[] = {
+    {"item-db", required_argument, NULL, table_item},
+    {"item-combo-db", required_argument, NULL, table_item_combo},
+    {"skill-db", required_argument, NULL, table_skill},
+    {"mob-db", required_argument, NULL, table_mob},
+    {"mercenary-db", required_argument, NULL, table_mercenary},
+    {"constant", required_argument, NULL, table_constant},
+    {"constant-data", required_argument, NULL, table_constant_data},
+    {"constant-group", required_argument, NULL, table_constant_group},
+    {"argument", required_argument, NULL, table_argument},
+    {"bonus", required_argument, NULL, table_bonus},
+    {"bonus2", required_argument, NULL, table_bonus2},
+    {"bonus3", required_argument, NULL, table_bonus3},
+    {"bonus4", required_argument, NULL, table_bonus4},
+    {"bonus5", required_argument, NULL, table_bonus5},
+    {"sc-start", required_argument, NULL, table_sc_start},
+    {"sc-start2", required_argument, NULL, table_sc_start2},
+    {"sc-start4", required_argument, NULL, table_sc_start4},
+    {"statement", required_argument, NULL, table_statement},
+    {NULL, 0, NULL, 0}
+};
+
 int item_print(struct script *, struct item_node *, struct strbuf *);
 void bonus_print(char *);
 void combo_print(char *, char *);
@@ -13,8 +67,19 @@ int main(int argc, char ** argv) {
     struct strbuf strbuf;
 
     struct item_node * item;
+    int type;
 
-    if(chdir(argv[1])) {
+    while(!status && (type = getopt_long(argc, argv, "", option, NULL)) != -1) {
+        if(type < 0 || type >= table_count) {
+            status = 1;
+        } else {
+            input[type] = optarg;
+        }
+    }
+
+    if(status || optind >= argc) {
+        status = panic("usage: pj59 [--<table> <path>]... <directory> [item id]");
+    } else if(chdir(argv[optind])) {
         status = panic("failed to change directory");
     } else if(heap_create(&heap, 4096)) {
         status = panic("failed to create heap object");
@@ -22,75 +87,44 @@ int main(int argc, char ** argv) {
         if(table_create(&table, 4096, &heap)) {
             status = panic("failed to create table object");
         } else {
-            if(table_item_parse(&table, "item_db.txt")) {
-                status = panic("failed to item parse table object");
-            } else if(table_item_combo_parse(&table, "item_combo_db.txt")) {
-                status = panic("failed to item combo parse table object");
-            } else if(table_skill_parse(&table, "skill_db.yml")) {
-                status = panic("failed to skill parse table object");
-            } else if(table_mob_parse(&table, "mob_db.txt")) {
-                status = panic("failed to mob parse table object");
-            } else if(table_mercenary_parse(&table, "mercenary_db.txt")) {
-                status = panic("failed to mercenary parse table object");
-            } else if(table_constant_parse(&table, "constant.yml")) {
-                status = panic("failed to constant parse table object");
-            } else if(table_constant_data_parse(&table, "constant_data.yml")) {
-                status = panic("failed to constant data parse table object");
-            } else if(table_constant_group_parse(&table, "constant_group.yml")) {
-                status = panic("failed to constant group parse table object");
-            } else if(table_argument_parse(&table, "argument.yml")) {
-                status = panic("failed to argument parse table object");
-            } else if(table_bonus_parse(&table, "bonus.yml")) {
-                status = panic("failed to bonus parse table object");
-            } else if(table_bonus2_parse(&table, "bonus2.yml")) {
-                status = panic("failed to bonus2 parse table object");
-            } else if(table_bonus3_parse(&table, "bonus3.yml")) {
-                status = panic("failed to bonus3 parse table object");
-            } else if(table_bonus4_parse(&table, "bonus4.yml")) {
-                status = panic("failed to bonus4 parse table object");
-            } else if(table_bonus5_parse(&table, "bonus5.yml")) {
-                status = panic("failed to bonus5 parse table object");
-            } else if(table_sc_start_parse(&table, "sc_start.yml")) {
-                status = panic("failed to sc_start parse table object");
-            } else if(table_sc_start2_parse(&table, "sc_start2.yml")) {
-                status = panic("failed to sc_start2 parse table object");
-            } else if(table_sc_start4_parse(&table, "sc_start4.yml")) {
-                status = panic("failed to sc_start4 parse table object");
-            } else if(table_statement_parse(&table, "statement.yml")) {
-                status = panic("failed to statement parse table object");
+            for(type = 0; type < table_count; type++)
+                table_path(&table, type, input[type]);
+
+            if(script_create(&script, 4096, &heap, &table)) {
+                status = panic("failed to create script object");
             } else {
-                if(script_setup(&table)) {
-                    status = panic("failed to setup script object");
-                } else if(script_create(&script, 4096, &heap, &table)) {
-                    status = panic("failed to create script object");
+                if(strbuf_create(&strbuf, 4096)) {
+                    status = panic("failed to create strbuf object");
                 } else {
-                    if(strbuf_create(&strbuf, 4096)) {
-                        status = panic("failed to create strbuf object");
-                    } else {
-                        if(argc < 3) {
-                            item = item_start(&table);
-                            while(item && !status) {
-                                if(item_print(&script, item, &strbuf)) {
-                                    status = panic("failed to print item - %ld", item->id);
-                                } else {
-                                    item = item_next(&table);
-                                }
-                            }
-                        } else {
-                            item = item_id(&table, strtol(argv[2], NULL, 0));
-                            if(!item) {
-                                status = panic("invalid item id - %s", argv[2]);
-                            } else if(item_print(&script, item, &strbuf)) {
+                    if(argc - optind < 2) {
+                        item = item_start(&table);
+                        while(item && !status) {
+                            if(item_print(&script, item, &strbuf)) {
                                 status = panic("failed to print item - %ld", item->id);
+                            } else {
+                                item = item_next(&table);
                             }
                         }
+                    } else {
+                        item = item_id(&table, strtol(argv[optind + 1], NULL, 0));
+                        if(!item && table.status) {
+                            status = panic("failed to load table object");
+                        } else if(!item) {
+                            status = panic("invalid item id - %s", argv[optind + 1]);
+                        } else if(item_print(&script, item, &strbuf)) {
+                            status = panic("failed to print item - %ld", item->id);
+                        }
+                    }
 
-                        undefined_print(&script.undefined);
+                    if(!status && table.status)
+                        status = panic("failed to load table object");
 
-                        strbuf_destroy(&strbuf);
-                    }
-                    script_destroy(&script);
+                    undefined_print(&script.undefined);
+                    logic_table_print(&script.logic_table);
+
+                    strbuf_destroy(&strbuf);
                 }
+                script_destroy(&script);
             }
             table_destroy(&table);
         }
@@ -101,6 +135,7 @@ int main(int argc, char ** argv) {
 }
 
 int item_print(struct script * script, struct item_node * item, struct strbuf * strbuf) {
+    int approximate;
     struct item_combo_node * combo;
 
     fprintf(
@@ -111,9 +146,12 @@ int item_print(struct script * script, struct item_node * item, struct strbuf *
         item->name
     );
 
-    if(script_compile(script, item->bonus, strbuf)) {
+    if(item_script(script->table, item)) {
+        return panic("failed to script item object");
+    } else if(script_compile(script, item->bonus, strbuf)) {
         return panic("failed to compile script object");
     } else {
+        approximate = script->approximate;
         bonus_print(strbuf_array(strbuf));
 
         if(item->combo) {
@@ -124,11 +162,15 @@ int item_print(struct script * script, struct item_node * item, struct strbuf *
                 if(script_compile(script, combo->bonus, strbuf)) {
                     return panic("failed to compile script object");
                 } else {
+                    approximate |= script->approximate;
                     combo_print(combo->combo, strbuf_array(strbuf));
                 }
                 combo = combo->next;
             }
         }
+
+        if(approximate)
+            fprintf(stdout, "  approximate: true\n");
     }
 
     return 0;
@@ -5,6 +5,9 @@ static inline long long_max(long, long);
 
 static inline struct range_node * range_node_create(struct range *, long, long);
 static inline void range_node_destroy(struct range *, struct range_node *);
+static inline void range_node_unlink(struct range *, struct range_node *);
+
+static int range_widen(struct range *);
 
 static inline long long_min(long x, long y) {
     return x < y ? x : y;
@@ -15,20 +18,45 @@ static inline long long_max(long x, long y) {
 }
 
 static inline struct range_node * range_node_create(struct range * range, long min, long max) {
-    struct range_node * node;
+    size_t i;
+    struct range_node * node = NULL;
+
+    for(i = 0; i < RANGE_SIZE && !node; i++) {
+        if(!(range->slot & (1 << i))) {
+            range->slot |= 1 << i;
+            node = &range->node[i];
+        }
+    }
+
+    if(!node)
+        node = pool_get(range->pool);
 
-    node = pool_get(range->pool);
     if(node) {
         node->min = min;
         node->max = max;
         node->next = NULL;
+        range->count++;
     }
 
     return node;
 }
 
 static inline void range_node_destroy(struct range * range, struct range_node * node) {
-    pool_put(range->pool, node);
+    range->count--;
+
+    if(node >= range->node && node < range->node + RANGE_SIZE) {
+        range->slot &= ~(1 << (node - range->node));
+    } else {
+        pool_put(range->pool, node);
+    }
+}
+
+static inline void range_node_unlink(struct range * range, struct range_node * prev) {
+    struct range_node * node;
+
+    node = prev->next;
+    prev->next = node->next;
+    range_node_destroy(range, node);
 }
 
 int range_create(struct range * range, struct pool * pool) {
@@ -42,6 +70,10 @@ int range_create(struct range * range, struct pool * pool) {
         range->last = NULL;
         range->min = 0;
         range->max = 0;
+        range->count = 0;
+        range->limit = RANGE_LIMIT;
+        range->approximate = 0;
+        range->slot = 0;
     }
 
     return status;
@@ -63,6 +95,29 @@ void range_clear(struct range * range) {
     range->last = NULL;
     range->min = 0;
     range->max = 0;
+    range->approximate = 0;
+}
+
+static int range_widen(struct range * range) {
+    int status = 0;
+    long min;
+    long max;
+
+    min = range->min;
+    max = range->max;
+
+    range_clear(range);
+
+    range->root = range_node_create(range, min, max);
+    if(!range->root) {
+        status = panic("failed to create range node object");
+    } else {
+        range->min = min;
+        range->max = max;
+        range->approximate = 1;
+    }
+
+    return status;
 }
 
 int range_add(struct range * range, long min, long max) {
@@ -86,18 +141,25 @@ int range_add(struct range * range, long min, long max) {
             iter = iter->next;
         }
 
-        node = range_node_create(range, min, max);
-        if(!node) {
-            status = panic("failed to create range node object");
+        if(iter && iter->min <= max + 1) {
+            node = iter;
+            node->min = long_min(node->min, min);
+            node->max = long_max(node->max, max);
+            iter = node->next;
         } else {
-            if(prev) {
+            node = range_node_create(range, min, max);
+            if(!node) {
+                status = panic("failed to create range node object");
+            } else if(prev) {
                 node->next = prev->next;
                 prev->next = node;
             } else {
                 node->next = range->root;
                 range->root = node;
             }
+        }
 
+        if(!status) {
             while(iter && iter->min <= node->max + 1) {
                 node->min = long_min(node->min, iter->min);
                 node->max = long_max(node->max, iter->max);
@@ -112,6 +174,9 @@ int range_add(struct range * range, long min, long max) {
                 range->max = node->max;
 
             range->last = prev;
+
+            if(range->limit && range->count > range->limit && range_widen(range))
+                status = panic("failed to widen range object");
         }
     }
 
@@ -180,6 +245,177 @@ int range_remove(struct range * range, long min, long max) {
             range->max = prev ? prev->max : 0;
 
         range->last = prev;
+
+        if(range->limit && range->count > range->limit && range_widen(range))
+            status = panic("failed to widen range object");
+    }
+
+    return status;
+}
+
+int range_array_create(struct range_array * array) {
+    array->min = array->buffer;
+    array->max = array->buffer + RANGE_ARRAY_SIZE;
+    array->count = 0;
+    array->total = RANGE_ARRAY_SIZE;
+    array->approximate = 0;
+
+    return 0;
+}
+
+void range_array_destroy(struct range_array * array) {
+    if(array->min != array->buffer)
+        free(array->min);
+
+    array->min = array->buffer;
+    array->max = array->buffer + RANGE_ARRAY_SIZE;
+    array->count = 0;
+    array->total = RANGE_ARRAY_SIZE;
+}
+
+int range_array_reserve(struct range_array * array, size_t count) {
+    int status = 0;
+    size_t total;
+    long * buffer;
+
+    if(array->total < count) {
+        total = long_max(array->total * 2, count);
+        buffer = malloc(total * 2 * sizeof(*buffer));
+        if(!buffer) {
+            status = panic("out of memory");
+        } else {
+            memcpy(buffer, array->min, array->count * sizeof(*buffer));
+            memcpy(buffer + total, array->max, array->count * sizeof(*buffer));
+            if(array->min != array->buffer)
+                free(array->min);
+            array->min = buffer;
+            array->max = buffer + total;
+            array->total = total;
+        }
+    }
+
+    return status;
+}
+
+int range_array_load(struct range_array * array, struct range * range) {
+    int status = 0;
+    struct range_node * iter;
+
+    array->count = 0;
+    array->approximate = range->approximate;
+
+    iter = range->root;
+    while(iter && !status) {
+        if(range_array_push(array, iter->min, iter->max)) {
+            status = panic("failed to push range array object");
+        } else {
+            iter = iter->next;
+        }
+    }
+
+    return status;
+}
+
+int range_array_push(struct range_array * array, long min, long max) {
+    int status = 0;
+
+    if(array->count >= array->total && range_array_reserve(array, array->count + 1)) {
+        status = panic("failed to reserve range array object");
+    } else {
+        array->min[array->count] = min;
+        array->max[array->count] = max;
+        array->count++;
+    }
+
+    return status;
+}
+
+void range_array_normalize(struct range_array * array) {
+    size_t i;
+    size_t j;
+    long min;
+    long max;
+
+    for(i = 1; i < array->count && array->min[i - 1] <= array->min[i]; i++);
+
+    if(i < array->count) {
+        for(j = 1; j < array->count && array->min[j - 1] > array->min[j]; j++);
+
+        if(j == array->count) {
+            for(i = 0, j = array->count - 1; i < j; i++, j--) {
+                min = array->min[i];
+                max = array->max[i];
+                array->min[i] = array->min[j];
+                array->max[i] = array->max[j];
+                array->min[j] = min;
+                array->max[j] = max;
+            }
+        } else {
+            for(; i < array->count; i++) {
+                min = array->min[i];
+                max = array->max[i];
+                for(j = i; j > 0 && array->min[j - 1] > min; j--) {
+                    array->min[j] = array->min[j - 1];
+                    array->max[j] = array->max[j - 1];
+                }
+                array->min[j] = min;
+                array->max[j] = max;
+            }
+        }
+    }
+
+    if(array->count) {
+        for(i = 1, j = 0; i < array->count; i++) {
+            if(array->min[i] <= array->max[j] + 1) {
+                array->max[j] = long_max(array->max[j], array->max[i]);
+            } else {
+                j++;
+                array->min[j] = array->min[i];
+                array->max[j] = array->max[i];
+            }
+        }
+        array->count = j + 1;
+    }
+}
+
+int range_array_store(struct range_array * array, struct range * range) {
+    int status = 0;
+    size_t i;
+    struct range_node * prev;
+    struct range_node * node;
+
+    if(range->limit && array->count > range->limit) {
+        array->max[0] = array->max[array->count - 1];
+        array->count = 1;
+        array->approximate = 1;
+    }
+
+    if(array->approximate)
+        range->approximate = 1;
+
+    if(range->root) {
+        for(i = 0; i < array->count && !status; i++)
+            if(range_add(range, array->min[i], array->max[i]))
+                status = panic("failed to add range object");
+    } else if(array->count) {
+        prev = NULL;
+        for(i = 0; i < array->count && !status; i++) {
+            node = range_node_create(range, array->min[i], array->max[i]);
+            if(!node) {
+                status = panic("failed to create range node object");
+            } else {
+                if(prev) {
+                    prev->next = node;
+                } else {
+                    range->root = node;
+                }
+                prev = node;
+            }
+        }
+
+        range->min = range->root->min;
+        range->max = prev->max;
+        range->last = NULL;
     }
 
     return status;
@@ -206,62 +442,144 @@ int range_assign(struct range * range, struct range * x) {
         iter = iter->next;
     }
 
+    if(x->approximate)
+        range->approximate = 1;
+
     return status;
 }
 
-int range_or(struct range * range, struct range * x, struct range * y) {
+int range_assign_move(struct range * range, struct range * x) {
     int status = 0;
-    struct range_node * l;
-    struct range_node * r;
+    struct range_node * prev;
+    struct range_node * iter;
+    struct range_node * node;
 
-    l = x->root;
-    r = y->root;
-    while(l && r && !status) {
-        if(l->min > r->max) {
-            if(range_add(range, r->min, r->max)) {
-                status = panic("failed to add range object");
+    if(range->root || range->pool != x->pool) {
+        if(range_assign(range, x))
+            status = panic("failed to assign range object");
+    } else if(x->root) {
+        prev = NULL;
+        while(x->root && !status) {
+            iter = x->root;
+            if(iter >= x->node && iter < x->node + RANGE_SIZE) {
+                node = range_node_create(range, iter->min, iter->max);
+                if(!node)
+                    status = panic("failed to create range node object");
             } else {
-                r = r->next;
+                node = iter;
+                range->count++;
+                x->count--;
             }
-        } else if(l->max < r->min) {
-            if(range_add(range, l->min, l->max)) {
-                status = panic("failed to add range object");
-            } else {
-                l = l->next;
-            }
-        } else {
-            if(l->max < r->max) {
-                if(range_add(range, l->min, l->max)) {
-                    status = panic("failed to add range object");
-                } else {
-                    l = l->next;
-                }
-            } else {
-                if(range_add(range, r->min, r->max)) {
-                    status = panic("failed to add range object");
+
+            if(!status) {
+                x->root = iter->next;
+                if(node != iter)
+                    range_node_destroy(x, iter);
+
+                node->next = NULL;
+                if(prev) {
+                    prev->next = node;
                 } else {
-                    r = r->next;
+                    range->root = node;
                 }
+                prev = node;
             }
         }
-    }
 
-    while(l && !status) {
-        if(range_add(range, l->min, l->max)) {
-            status = panic("failed to add range object");
-        } else {
-            l = l->next;
+        if(prev) {
+            range->min = range->root->min;
+            range->max = prev->max;
+            range->last = NULL;
         }
+
+        if(x->approximate)
+            range->approximate = 1;
     }
 
-    while(r && !status) {
-        if(range_add(range, r->min, r->max)) {
-            status = panic("failed to add range object");
-        } else {
-            r = r->next;
+    range_clear(x);
+
+    return status;
+}
+
+static int range_or_array(struct range_array * array, struct range * x, struct range * y) {
+    int status = 0;
+    size_t i;
+    size_t j;
+    size_t k;
+    int c;
+    struct range_array l;
+    struct range_array r;
+
+    range_array_create(&l);
+    range_array_create(&r);
+
+    if(range_array_load(&l, x) || range_array_load(&r, y)) {
+        status = panic("failed to load range array object");
+    } else if(range_array_reserve(array, l.count + r.count)) {
+        status = panic("failed to reserve range array object");
+    } else {
+        i = j = k = 0;
+        while(i < l.count && j < r.count) {
+            c = l.min[i] <= r.min[j];
+            array->min[k] = c ? l.min[i] : r.min[j];
+            array->max[k] = c ? l.max[i] : r.max[j];
+            i += c;
+            j += !c;
+            k++;
         }
+        for(; i < l.count; i++, k++) {
+            array->min[k] = l.min[i];
+            array->max[k] = l.max[i];
+        }
+        for(; j < r.count; j++, k++) {
+            array->min[k] = r.min[j];
+            array->max[k] = r.max[j];
+        }
+        array->count = k;
+        array->approximate = l.approximate || r.approximate;
+
+        range_array_normalize(array);
+    }
+
+    range_array_destroy(&r);
+    range_array_destroy(&l);
+
+    return status;
+}
+
+int range_or(struct range * range, struct range * x, struct range * y) {
+    int status = 0;
+    struct range_array array;
+
+    range_array_create(&array);
+
+    if(range_or_array(&array, x, y)) {
+        status = panic("failed to compute range array object");
+    } else if(range_array_store(&array, range)) {
+        status = panic("failed to store range array object");
+    }
+
+    range_array_destroy(&array);
+
+    return status;
+}
+
+int range_or_into(struct range * range, struct range * y) {
+    int status = 0;
+    struct range_array array;
+
+    range_array_create(&array);
+
+    if(range_or_array(&array, range, y)) {
+        status = panic("failed to compute range array object");
+    } else {
+        range_clear(range);
+        if(range_array_store(&array, range))
+            status = panic("failed to store range array object");
     }
 
+    range_array_destroy(&array);
+
     return status;
 }
 
@@ -271,45 +589,72 @@ int range_and(struct range * range, struct range * x, struct range * y) {
 
 int range_not(struct range * range, struct range * x) {
     int status = 0;
-    struct range_node * iter;
+    size_t i;
+    struct range_array array;
 
-    iter = x->root;
-    while(iter && !status) {
-        if(iter->next && range_add(range, iter->max + 1, iter->next->min - 1)) {
-            status = panic("failed to add range object");
-        } else {
-            iter = iter->next;
+    range_array_create(&array);
+
+    if(range_array_load(&array, x)) {
+        status = panic("failed to load range array object");
+    } else if(array.count) {
+        for(i = 0; i + 1 < array.count; i++) {
+            array.min[i] = array.max[i] + 1;
+            array.max[i] = array.min[i + 1] - 1;
         }
+        array.count--;
+
+        if(range_array_store(&array, range))
+            status = panic("failed to store range array object");
     }
 
+    range_array_destroy(&array);
+
     return status;
 }
 
 int range_equal(struct range * range, struct range * x, struct range * y) {
     int status = 0;
-    struct range_node * l;
-    struct range_node * r;
-
-    l = x->root;
-    r = y->root;
-    while(l && r && !status) {
-        if(l->min > r->max) {
-            r = r->next;
-        } else if(l->max < r->min) {
-            l = l->next;
-        } else {
-            if(range_add(range, long_max(l->min, r->min), long_min(l->max, r->max))) {
-                status = panic("failed to add range object");
-            } else {
-                if(l->max < r->max) {
-                    l = l->next;
-                } else {
-                    r = r->next;
-                }
-            }
+    size_t i;
+    size_t j;
+    size_t k;
+    int c;
+    long min;
+    long max;
+    struct range_array l;
+    struct range_array r;
+    struct range_array array;
+
+    range_array_create(&l);
+    range_array_create(&r);
+    range_array_create(&array);
+
+    if(range_array_load(&l, x) || range_array_load(&r, y)) {
+        status = panic("failed to load range array object");
+    } else if(range_array_reserve(&array, l.count + r.count)) {
+        status = panic("failed to reserve range array object");
+    } else {
+        i = j = k = 0;
+        while(i < l.count && j < r.count) {
+            min = long_max(l.min[i], r.min[j]);
+            max = long_min(l.max[i], r.max[j]);
+            array.min[k] = min;
+            array.max[k] = max;
+            k += min <= max;
+            c = l.max[i] < r.max[j];
+            i += c;
+            j += !c;
         }
+        array.count = k;
+        array.approximate = l.approximate || r.approximate;
+
+        if(range_array_store(&array, range))
+            status = panic("failed to store range array object");
     }
 
+    range_array_destroy(&array);
+    range_array_destroy(&r);
+    range_array_destroy(&l);
+
     return status;
 }
 
@@ -367,6 +712,9 @@ int range_not_equal(struct range * range, struct range * x, struct range * y) {
         }
     }
 
+    if(x->approximate || y->approximate)
+        range->approximate = 1;
+
     return status;
 }
 
@@ -383,6 +731,9 @@ int range_lesser(struct range * range, struct range * x, struct range * y) {
         }
     }
 
+    if(x->approximate || y->approximate)
+        range->approximate = 1;
+
     return status;
 }
 
@@ -399,6 +750,9 @@ int range_lesser_equal(struct range * range, struct range * x, struct range * y)
         }
     }
 
+    if(x->approximate || y->approximate)
+        range->approximate = 1;
+
     return status;
 }
 
@@ -418,6 +772,9 @@ int range_greater(struct range * range, struct range * x, struct range * y) {
         }
     }
 
+    if(x->approximate || y->approximate)
+        range->approximate = 1;
+
     return status;
 }
 
@@ -437,29 +794,70 @@ int range_greater_equal(struct range * range, struct range * x, struct range * y
         }
     }
 
+    if(x->approximate || y->approximate)
+        range->approximate = 1;
+
     return status;
 }
 
 #define range_unary(name, unary)                                        \
                                                                         \
-int range_##name(struct range * range, struct range * x) {              \
+static int range_##name##_array(struct range_array * array,             \
+                                struct range * x) {                     \
     int status = 0;                                                     \
+    size_t i;                                                           \
     long l;                                                             \
     long r;                                                             \
-    struct range_node * iter;                                           \
                                                                         \
-    iter = x->root;                                                     \
-    while(iter && !status) {                                            \
-        l = unary iter->min;                                            \
-        r = unary iter->max;                                            \
-                                                                        \
-        if( l < r ? range_add(range, l, r) : range_add(range, r, l)) {  \
-            status = panic("failed to add range object");               \
-        } else {                                                        \
-            iter = iter->next;                                          \
+    if(range_array_load(array, x)) {                                    \
+        status = panic("failed to load range array object");            \
+    } else {                                                            \
+        for(i = 0; i < array->count; i++) {                             \
+            l = unary array->min[i];                                    \
+            r = unary array->max[i];                                    \
+            array->min[i] = l < r ? l : r;                              \
+            array->max[i] = l < r ? r : l;                              \
         }                                                               \
+                                                                        \
+        range_array_normalize(array);                                   \
+    }                                                                   \
+                                                                        \
+    return status;                                                      \
+}                                                                       \
+                                                                        \
+int range_##name(struct range * range, struct range * x) {              \
+    int status = 0;                                                     \
+    struct range_array array;                                           \
+                                                                        \
+    range_array_create(&array);                                         \
+                                                                        \
+    if(range_##name##_array(&array, x)) {                               \
+        status = panic("failed to compute range array object");         \
+    } else if(range_array_store(&array, range)) {                       \
+        status = panic("failed to store range array object");           \
     }                                                                   \
                                                                         \
+    range_array_destroy(&array);                                        \
+                                                                        \
+    return status;                                                      \
+}                                                                       \
+                                                                        \
+int range_##name##_into(struct range * range) {                         \
+    int status = 0;                                                     \
+    struct range_array array;                                           \
+                                                                        \
+    range_array_create(&array);                                         \
+                                                                        \
+    if(range_##name##_array(&array, range)) {                           \
+        status = panic("failed to compute range array object");         \
+    } else {                                                            \
+        range_clear(range);                                             \
+        if(range_array_store(&array, range))                            \
+            status = panic("failed to store range array object");       \
+    }                                                                   \
+                                                                        \
+    range_array_destroy(&array);                                        \
+                                                                        \
     return status;                                                      \
 }
 
@@ -469,24 +867,69 @@ range_unary(bit_not, ~)
 
 #define range_binary(name, binary)                                              \
                                                                                 \
-int range_##name(struct range * range, struct range * x, struct range * y) {    \
+static int range_##name##_array(struct range_array * array,                     \
+                                struct range * x,                               \
+                                struct range * y) {                             \
     int status = 0;                                                             \
+    size_t i;                                                                   \
     long l;                                                                     \
     long r;                                                                     \
-    struct range_node * iter;                                                   \
-                                                                                \
-    iter = x->root;                                                             \
-    while(iter && !status) {                                                    \
-        l = iter->min binary y->min;                                            \
-        r = iter->max binary y->max;                                            \
+    long min;                                                                   \
+    long max;                                                                   \
                                                                                 \
-        if( l < r ? range_add(range, l, r) : range_add(range, r, l)) {          \
-            status = panic("failed to add range object");                       \
-        } else {                                                                \
-            iter = iter->next;                                                  \
+    if(range_array_load(array, x)) {                                            \
+        status = panic("failed to load range array object");                    \
+    } else {                                                                    \
+        min = y->min;                                                           \
+        max = y->max;                                                           \
+        if(y->approximate)                                                      \
+            array->approximate = 1;                                             \
+        for(i = 0; i < array->count; i++) {                                     \
+            l = array->min[i] binary min;                                       \
+            r = array->max[i] binary max;                                       \
+            array->min[i] = l < r ? l : r;                                      \
+            array->max[i] = l < r ? r : l;                                      \
         }                                                                       \
+                                                                                \
+        range_array_normalize(array);                                           \
+    }                                                                           \
+                                                                                \
+    return status;                                                              \
+}                                                                               \
+                                                                                \
+int range_##name(struct range * range, struct range * x, struct range * y) {    \
+    int status = 0;                                                             \
+    struct range_array array;                                                   \
+                                                                                \
+    range_array_create(&array);                                                 \
+                                                                                \
+    if(range_##name##_array(&array, x, y)) {                                    \
+        status = panic("failed to compute range array object");                 \
+    } else if(range_array_store(&array, range)) {                               \
+        status = panic("failed to store range array object");                   \
     }                                                                           \
                                                                                 \
+    range_array_destroy(&array);                                                \
+                                                                                \
+    return status;                                                              \
+}                                                                               \
+                                                                                \
+int range_##name##_into(struct range * range, struct range * y) {               \
+    int status = 0;                                                             \
+    struct range_array array;                                                   \
+                                                                                \
+    range_array_create(&array);                                                 \
+                                                                                \
+    if(range_##name##_array(&array, range, y)) {                                \
+        status = panic("failed to compute range array object");                 \
+    } else {                                                                    \
+        range_clear(range);                                                     \
+        if(range_array_store(&array, range))                                    \
+            status = panic("failed to store range array object");               \
+    }                                                                           \
+                                                                                \
+    range_array_destroy(&array);                                                \
+                                                                                \
     return status;                                                              \
 }
 
@@ -514,9 +957,39 @@ int range_increment(struct range * range, struct range * x) {
         }
     }
 
+    if(x->approximate)
+        range->approximate = 1;
+
     return status;
 }
 
+int range_increment_into(struct range * range) {
+    struct range_node * prev;
+    struct range_node * iter;
+
+    prev = NULL;
+    iter = range->root;
+    while(iter) {
+        iter->max++;
+        if(prev && iter->min <= prev->max + 1) {
+            prev->max = long_max(prev->max, iter->max);
+            range_node_unlink(range, prev);
+            iter = prev->next;
+        } else {
+            prev = iter;
+            iter = iter->next;
+        }
+    }
+
+    if(prev) {
+        range->min = range->root->min;
+        range->max = prev->max;
+    }
+    range->last = NULL;
+
+    return 0;
+}
+
 int range_decrement(struct range * range, struct range * x) {
     int status = 0;
     struct range_node * iter;
@@ -530,15 +1003,48 @@ int range_decrement(struct range * range, struct range * x) {
         }
     }
 
+    if(x->approximate)
+        range->approximate = 1;
+
     return status;
 }
 
+int range_decrement_into(struct range * range) {
+    struct range_node * prev;
+    struct range_node * iter;
+
+    prev = NULL;
+    iter = range->root;
+    while(iter) {
+        iter->min--;
+        if(prev && iter->min <= prev->max + 1) {
+            prev->max = long_max(prev->max, iter->max);
+            range_node_unlink(range, prev);
+            iter = prev->next;
+        } else {
+            prev = iter;
+            iter = iter->next;
+        }
+    }
+
+    if(prev) {
+        range->min = range->root->min;
+        range->max = prev->max;
+    }
+    range->last = NULL;
+
+    return 0;
+}
+
 int range_min(struct range * range, struct range * x, struct range * y) {
     int status = 0;
 
     if(range_add(range, long_min(x->min, y->min), long_min(x->max, y->max)))
         status = panic("failed to add range object");
 
+    if(x->approximate || y->approximate)
+        range->approximate = 1;
+
     return status;
 }
 
@@ -548,6 +1054,9 @@ int range_max(struct range * range, struct range * x, struct range * y) {
     if(range_add(range, long_max(x->min, y->min), long_max(x->max, y->max)))
         status = panic("failed to add range object");
 
+    if(x->approximate || y->approximate)
+        range->approximate = 1;
+
     return status;
 }
 
@@ -564,5 +1073,8 @@ int range_pow(struct range * range, struct range * x, struct range * y) {
         }
     }
 
+    if(x->approximate || y->approximate)
+        range->approximate = 1;
+
     return status;
 }
@@ -3,6 +3,17 @@
 
 #include "pool.h"
 
+#define RANGE_SIZE 2
+#define RANGE_ARRAY_SIZE 16
+
+/*
+ * ranges with more than RANGE_LIMIT intervals are widened to
+ * their hull and flagged approximate; a limit of zero disables
+ */
+#ifndef RANGE_LIMIT
+#define RANGE_LIMIT 32
+#endif
+
 struct range_node {
     long min;
     long max;
@@ -15,9 +26,34 @@ struct range {
     struct range_node * last;
     long min;
     long max;
+    size_t count;
+    size_t limit;
+    int approximate;
+    unsigned int slot;
+    struct range_node node[RANGE_SIZE];
 };
 
+struct range_array {
+    long * min;
+    long * max;
+    size_t count;
+    size_t total;
+    int approximate;
+    long buffer[RANGE_ARRAY_SIZE * 2];
+};
+
+int range_array_create(struct range_array *);
+void range_array_destroy(struct range_array *);
+int range_array_reserve(struct range_array *, size_t);
+int range_array_load(struct range_array *, struct range *);
+int range_array_push(struct range_array *, long, long);
+void range_array_normalize(struct range_array *);
+int range_array_store(struct range_array *, struct range *);
+
 typedef int (*range_cb) (struct range *, struct range *, struct range *);
+typedef int (*range_into_cb) (struct range *, struct range *);
+typedef int (*range_unary_cb) (struct range *, struct range *);
+typedef int (*range_unary_into_cb) (struct range *);
 
 int range_create(struct range *, struct pool *);
 void range_destroy(struct range *);
@@ -26,7 +62,9 @@ int range_add(struct range *, long, long);
 int range_remove(struct range *, long, long);
 void range_print(struct range *);
 int range_assign(struct range *, struct range *);
+int range_assign_move(struct range *, struct range *);
 int range_or(struct range *, struct range *, struct range *);
+int range_or_into(struct range *, struct range *);
 int range_and(struct range *, struct range *, struct range *);
 int range_not(struct range *, struct range *);
 int range_equal(struct range *, struct range *, struct range *);
@@ -36,20 +74,35 @@ int range_lesser_equal(struct range *, struct range *, struct range *);
 int range_greater(struct range *, struct range *, struct range *);
 int range_greater_equal(struct range *, struct range *, struct range *);
 int range_plus_unary(struct range *, struct range *);
+int range_plus_unary_into(struct range *);
 int range_minus_unary(struct range *, struct range *);
+int range_minus_unary_into(struct range *);
 int range_bit_not(struct range *, struct range *);
+int range_bit_not_into(struct range *);
 int range_bit_or(struct range *, struct range *, struct range *);
+int range_bit_or_into(struct range *, struct range *);
 int range_bit_xor(struct range *, struct range *, struct range *);
+int range_bit_xor_into(struct range *, struct range *);
 int range_bit_and(struct range *, struct range *, struct range *);
+int range_bit_and_into(struct range *, struct range *);
 int range_bit_left(struct range *, struct range *, struct range *);
+int range_bit_left_into(struct range *, struct range *);
 int range_bit_right(struct range *, struct range *, struct range *);
+int range_bit_right_into(struct range *, struct range *);
 int range_plus(struct range *, struct range *, struct range *);
+int range_plus_into(struct range *, struct range *);
 int range_minus(struct range *, struct range *, struct range *);
+int range_minus_into(struct range *, struct range *);
 int range_multiply(struct range *, struct range *, struct range *);
+int range_multiply_into(struct range *, struct range *);
 int range_divide(struct range *, struct range *, struct range *);
+int range_divide_into(struct range *, struct range *);
 int range_remainder(struct range *, struct range *, struct range *);
+int range_remainder_into(struct range *, struct range *);
 int range_increment(struct range *, struct range *);
+int range_increment_into(struct range *);
 int range_decrement(struct range *, struct range *);
+int range_decrement_into(struct range *);
 int range_min(struct range *, struct range *, struct range *);
 int range_max(struct range *, struct range *, struct range *);
 int range_pow(struct range *, struct range *, struct range *);
@@ -21,6 +21,9 @@ long ATF_TARGET;
 long ATF_WEAPON;
 
 int table_set_constant(struct table *, char *, long *);
+int script_table_setup(struct script *);
+int script_group_setup(struct script *);
+int script_link(struct argument *, struct script *);
 
 int script_map_push(struct script *, struct map *);
 void script_map_pop(struct script *);
@@ -28,8 +31,8 @@ void script_map_pop(struct script *);
 int script_logic_push(struct script *, struct logic *);
 void script_logic_pop(struct script *);
 
-int script_stack_push(struct script *, struct stack *);
-void script_stack_pop(struct script *);
+int script_vector_push(struct script *, struct vector *);
+void script_vector_pop(struct script *);
 
 int script_strbuf_push(struct script *, struct strbuf *);
 void script_strbuf_pop(struct script *);
@@ -38,6 +41,10 @@ int script_map_logic_push(struct script *, struct map *);
 void script_map_logic_pop(struct script *);
 
 struct script_range * script_range_create(struct script *, enum script_type, char *, ...);
+int script_range_push(struct script *, struct script_range *);
+int script_range_binary(struct script *, struct script_range *, struct script_range *, range_cb, range_into_cb, char *, struct script_range **);
+int script_range_unary(struct script *, struct script_range *, range_unary_cb, range_unary_into_cb, char *, struct script_range **);
+int script_range_logic(struct script *, struct script_range *, struct script_range *, char *, struct script_range **);
 
 int script_logic_create(struct script *, struct logic_node *, struct map *);
 int script_logic_cond(struct script *, struct script_range *, struct map *, range_cb);
@@ -46,31 +53,124 @@ int script_logic_not_cond(struct script *, struct script_range *, struct map *,
 enum script_flag {
     is_logic = 0x1,
     is_array = 0x2,
-    is_concat = 0x4
+    is_concat = 0x4,
+    is_statement = 0x8
+};
+
+enum script_comma {
+    comma_x = 0x1,
+    comma_y = 0x2
+};
+
+enum script_opcode {
+    op_integer,
+    op_string,
+    op_variable,
+    op_constant,
+    op_execute,
+    op_vector_push,
+    op_argument,
+    op_function,
+    op_call,
+    op_undefined,
+    op_vector_pop,
+    op_map_logic,
+    op_comma,
+    op_assign,
+    op_plus_assign,
+    op_minus_assign,
+    op_logic_push,
+    op_logic_pop,
+    op_logic_top_push,
+    op_logic_top_pop,
+    op_question,
+    op_colon,
+    op_bit_or,
+    op_bit_xor,
+    op_bit_and,
+    op_bit_left,
+    op_bit_right,
+    op_plus_left,
+    op_concat_left,
+    op_plus_right,
+    op_concat_right,
+    op_plus,
+    op_minus,
+    op_multiply,
+    op_divide,
+    op_remainder,
+    op_plus_unary,
+    op_minus_unary,
+    op_bit_not,
+    op_increment,
+    op_decrement,
+    op_or,
+    op_and,
+    op_not,
+    op_equal,
+    op_not_equal,
+    op_lesser,
+    op_lesser_equal,
+    op_greater,
+    op_greater_equal,
+    op_if_begin,
+    op_if_end,
+    op_else_end,
+    op_statement
+};
+
+/*
+ * the vector, logic and strbuf objects pushed by the ops
+ * of a function call, a condition or an if statement
+ */
+struct script_frame {
+    int opcode;
+    union {
+        struct vector vector;
+        struct logic logic;
+        struct map map;
+    };
+    struct strbuf * strbuf;
+    struct script_frame * next;
 };
 
 int script_generate(struct script *, char *, struct strbuf *);
 int script_parse(struct script *, char *);
-int script_translate(struct script *, struct script_node *);
-int script_translate_if(struct script *, struct script_node *, char *, ...);
-int script_evaluate(struct script *, struct script_node *, int, struct script_range **);
-struct script_range * script_execute(struct script *, struct stack *, struct argument_node *);
-int script_optional(struct script *, struct stack *, struct argument_node *);
-
-struct script_range * function_set(struct script *, struct stack *);
-struct script_range * function_min(struct script *, struct stack *);
-struct script_range * function_max(struct script *, struct stack *);
-struct script_range * function_pow(struct script *, struct stack *);
-struct script_range * function_rand(struct script *, struct stack *);
-struct script_range * function_bonus(struct script *, struct stack *);
-struct script_range * function_bonus2(struct script *, struct stack *);
-struct script_range * function_bonus3(struct script *, struct stack *);
-struct script_range * function_bonus4(struct script *, struct stack *);
-struct script_range * function_bonus5(struct script *, struct stack *);
-struct script_range * function_getskilllv(struct script *, struct stack *);
-struct script_range * function_constant(struct script *, struct stack *);
-
-typedef struct script_range * (*function_cb) (struct script *, struct stack *);
+int script_code(struct script *, char *, int, struct script_code **);
+int script_symbol(struct script *, char *, int, struct script_symbol **);
+void script_code_destroy(struct map *);
+int script_lower(struct script *, struct script_code *, struct store *, struct script_node *, int);
+int script_lower_statement(struct script *, struct script_code *, struct store *, struct script_node *);
+int script_lower_if(struct script *, struct script_code *, struct store *, struct script_node *, int);
+int script_lower_expression(struct script *, struct script_code *, struct store *, struct script_node *, int);
+int script_lower_unary(struct script *, struct script_code *, struct store *, struct script_node *, int, int);
+int script_lower_binary(struct script *, struct script_code *, struct store *, struct script_node *, int, int);
+int script_lower_logic(struct script *, struct script_code *, struct store *, struct script_node *, int, int, int);
+int script_lower_concat(struct script *, struct script_code *, struct store *, struct script_node *, int, int, int, size_t *);
+struct script_op * script_emit(struct script_code *, int, int);
+struct script_op * script_emit_identifier(struct script_code *, int, int, struct store *, char *);
+int script_run(struct script *, struct script_code *, struct script_range **);
+struct script_frame * script_frame_push(struct script *, struct script_frame *, int);
+struct script_frame * script_frame_pop(struct script *, struct script_frame *);
+int script_run_if(struct script *, struct script_frame *, char *);
+int script_range_compare(struct script *, struct script_range *, struct script_range *, int, range_cb, range_cb, char *, struct script_range **);
+struct script_range * script_execute(struct script *, struct vector *, struct argument_node *);
+int script_optional(struct script *, struct vector *, struct argument_node *);
+
+struct script_range * function_set(struct script *, struct vector *);
+struct script_range * function_min(struct script *, struct vector *);
+struct script_range * function_max(struct script *, struct vector *);
+struct script_range * function_pow(struct script *, struct vector *);
+struct script_range * function_rand(struct script *, struct vector *);
+struct script_range * function_bonus(struct script *, struct vector *);
+struct script_range * function_bonus2(struct script *, struct vector *);
+struct script_range * function_bonus3(struct script *, struct vector *);
+struct script_range * function_bonus4(struct script *, struct vector *);
+struct script_range * function_bonus5(struct script *, struct vector *);
+struct script_range * function_getskilllv(struct script *, struct vector *);
+struct script_range * function_constant(struct script *, struct vector *);
+
+typedef struct script_range * (*function_cb) (struct script *, struct vector *);
 
 struct function_entry {
     char * identifier;
@@ -94,44 +194,44 @@ struct function_entry {
     { NULL, NULL}
 };
 
-int entry_node_load(struct entry_node *, struct stack *, struct stack *);
-int entry_node_call(struct entry_node *, struct script *, struct stack *, struct strbuf *);
-int print_node_write(struct print_node *, struct script *, struct stack *, struct strbuf *);
-
-int argument_print(struct script *, struct stack *, struct argument_node *, struct strbuf *);
-int argument_prefix(struct script *, struct stack *, struct argument_node *, struct strbuf *);
-int argument_zero(struct script *, struct stack *, struct argument_node *, struct strbuf *);
-int argument_array(struct script *, struct stack *, struct argument_node *, struct strbuf *);
-int argument_integer(struct script *, struct stack *, struct argument_node *, struct strbuf *);
-int argument_string(struct script *, struct stack *, struct argument_node *, struct strbuf *);
-int argument_second(struct script *, struct stack *, struct argument_node *, struct strbuf *);
-int argument_millisecond(struct script *, struct stack *, struct argument_node *, struct strbuf *);
-int argument_constant(struct script *, struct stack *, struct argument_node *, struct strbuf *);
-int argument_item(struct script *, struct stack *, struct argument_node *, struct strbuf *);
-int argument_skill(struct script *, struct stack *, struct argument_node *, struct strbuf *);
-int argument_mob(struct script *, struct stack *, struct argument_node *, struct strbuf *);
-int argument_mercenary(struct script *, struct stack *, struct argument_node *, struct strbuf *);
-
-int argument_group(struct script *, struct stack *, struct strbuf *, char *);
-int argument_element(struct script *, struct stack *, struct argument_node *, struct strbuf *);
-int argument_equip(struct script *, struct stack *, struct argument_node *, struct strbuf *);
-int argument_job(struct script *, struct stack *, struct argument_node *, struct strbuf *);
-int argument_size(struct script *, struct stack *, struct argument_node *, struct strbuf *);
-int argument_race(struct script *, struct stack *, struct argument_node *, struct strbuf *);
-int argument_mob_race(struct script *, struct stack *, struct argument_node *, struct strbuf *);
-int argument_effect(struct script *, struct stack *, struct argument_node *, struct strbuf *);
-int argument_class(struct script *, struct stack *, struct argument_node *, struct strbuf *);
-int argument_splash(struct script *, struct stack *, struct argument_node *, struct strbuf *);
-int argument_bf(struct script *, struct stack *, struct argument_node *, struct strbuf *);
-int argument_atf_target(struct script *, struct stack *, struct argument_node *, struct strbuf *);
-int argument_atf_trigger(struct script *, struct stack *, struct argument_node *, struct strbuf *);
-int argument_script(struct script *, struct stack *, struct argument_node *, struct strbuf *);
-
-int argument_sc_start(struct script *, struct stack *, struct argument_node *, struct strbuf *);
-int argument_sc_start2(struct script *, struct stack *, struct argument_node *, struct strbuf *);
-int argument_sc_start4(struct script *, struct stack *, struct argument_node *, struct strbuf *);
-
-typedef int (*argument_cb) (struct script *, struct stack *, struct argument_node *, struct strbuf *);
+int entry_node_load(struct entry_node *, struct vector *, struct vector *);
+int entry_node_call(struct entry_node *, struct script *, struct vector *, struct strbuf *);
+int print_node_write(struct print_node *, struct script *, struct vector *, struct strbuf *);
+
+int argument_print(struct script *, struct vector *, struct argument_node *, struct strbuf *);
+int argument_prefix(struct script *, struct vector *, struct argument_node *, struct strbuf *);
+int argument_zero(struct script *, struct vector *, struct argument_node *, struct strbuf *);
+int argument_array(struct script *, struct vector *, struct argument_node *, struct strbuf *);
+int argument_integer(struct script *, struct vector *, struct argument_node *, struct strbuf *);
+int argument_string(struct script *, struct vector *, struct argument_node *, struct strbuf *);
+int argument_second(struct script *, struct vector *, struct argument_node *, struct strbuf *);
+int argument_millisecond(struct script *, struct vector *, struct argument_node *, struct strbuf *);
+int argument_constant(struct script *, struct vector *, struct argument_node *, struct strbuf *);
+int argument_item(struct script *, struct vector *, struct argument_node *, struct strbuf *);
+int argument_skill(struct script *, struct vector *, struct argument_node *, struct strbuf *);
+int argument_mob(struct script *, struct vector *, struct argument_node *, struct strbuf *);
+int argument_mercenary(struct script *, struct vector *, struct argument_node *, struct strbuf *);
+
+int argument_group(struct script *, struct vector *, struct strbuf *, enum script_group);
+int argument_element(struct script *, struct vector *, struct argument_node *, struct strbuf *);
+int argument_equip(struct script *, struct vector *, struct argument_node *, struct strbuf *);
+int argument_job(struct script *, struct vector *, struct argument_node *, struct strbuf *);
+int argument_size(struct script *, struct vector *, struct argument_node *, struct strbuf *);
+int argument_race(struct script *, struct vector *, struct argument_node *, struct strbuf *);
+int argument_mob_race(struct script *, struct vector *, struct argument_node *, struct strbuf *);
+int argument_effect(struct script *, struct vector *, struct argument_node *, struct strbuf *);
+int argument_class(struct script *, struct vector *, struct argument_node *, struct strbuf *);
+int argument_splash(struct script *, struct vector *, struct argument_node *, struct strbuf *);
+int argument_bf(struct script *, struct vector *, struct argument_node *, struct strbuf *);
+int argument_atf_target(struct script *, struct vector *, struct argument_node *, struct strbuf *);
+int argument_atf_trigger(struct script *, struct vector *, struct argument_node *, struct strbuf *);
+int argument_script(struct script *, struct vector *, struct argument_node *, struct strbuf *);
+
+int argument_sc_start(struct script *, struct vector *, struct argument_node *, struct strbuf *);
+int argument_sc_start2(struct script *, struct vector *, struct argument_node *, struct strbuf *);
+int argument_sc_start4(struct script *, struct vector *, struct argument_node *, struct strbuf *);
+
+typedef int (*argument_cb) (struct script *, struct vector *, struct argument_node *, struct strbuf *);
 
 struct argument_entry {
     char * identifier;
@@ -336,6 +436,7 @@ int script_create(struct script * script, size_t size, struct heap * heap, struc
 
     script->heap = heap;
     script->table = table;
+    script->setup = 0;
 
     if(!script->heap) {
         status = panic("invalid heap object");
@@ -351,15 +452,27 @@ int script_create(struct script * script, size_t size, struct heap * heap, struc
         } else if(store_create(&script->store, size)) {
             status = panic("failed to create store object");
             goto store_fail;
+        } else if(store_create(&script->code_store, size)) {
+            status = panic("failed to create store object");
+            goto code_store_fail;
+        } else if(map_create(&script->code_map, (map_compare_cb) strcmp, heap->map_pool)) {
+            status = panic("failed to create map object");
+            goto code_map_fail;
+        } else if(map_create(&script->optional_map, (map_compare_cb) strcmp, heap->map_pool)) {
+            status = panic("failed to create map object");
+            goto optional_map_fail;
+        } else if(map_create(&script->symbol_map, (map_compare_cb) strcmp, heap->map_pool)) {
+            status = panic("failed to create map object");
+            goto symbol_map_fail;
         } else if(stack_create(&script->map_stack, heap->stack_pool)) {
             status = panic("failed to create stack object");
             goto map_fail;
         } else if(stack_create(&script->logic_stack, heap->stack_pool)) {
             status = panic("failed to create stack object");
             goto logic_fail;
-        } else if(stack_create(&script->stack_stack, heap->stack_pool)) {
+        } else if(stack_create(&script->vector_stack, heap->stack_pool)) {
             status = panic("failed to create stack object");
-            goto stack_fail;
+            goto vector_fail;
         } else if(stack_create(&script->strbuf_stack, heap->stack_pool)) {
             status = panic("failed to create stack object");
             goto strbuf_fail;
@@ -372,6 +485,9 @@ int script_create(struct script * script, size_t size, struct heap * heap, struc
         } else if(map_create(&script->argument, (map_compare_cb) strcmp, heap->map_pool)) {
             status = panic("failed to create map object");
             goto argument_fail;
+        } else if(logic_table_create(&script->logic_table, heap->logic_pool, heap->term_pool, heap->map_pool)) {
+            status = panic("failed to create logic table object");
+            goto logic_table_fail;
         } else if(script_buffer_create(&script->buffer, size, heap)) {
             status = panic("failed to create script buffer object");
             goto buffer_fail;
@@ -397,18 +513,26 @@ int script_create(struct script * script, size_t size, struct heap * heap, struc
                 }
             }
 
-            if(status)
+            if(status) {
                 goto script_fail;
+            } else if(table_link(script->table, (table_link_cb) script_link, script)) {
+                status = panic("failed to link table object");
+                goto link_fail;
+            }
         }
     }
 
     return status;
 
+link_fail:
+    table_link(script->table, NULL, NULL);
 script_fail:
     undefined_destroy(&script->undefined);
 undef_fail:
     script_buffer_destroy(&script->buffer);
 buffer_fail:
+    logic_table_destroy(&script->logic_table);
+logic_table_fail:
     map_destroy(&script->argument);
 argument_fail:
     map_destroy(&script->function);
@@ -417,12 +541,20 @@ function_fail:
 map_logic_fail:
     stack_destroy(&script->strbuf_stack);
 strbuf_fail:
-    stack_destroy(&script->stack_stack);
-stack_fail:
+    stack_destroy(&script->vector_stack);
+vector_fail:
     stack_destroy(&script->logic_stack);
 logic_fail:
     stack_destroy(&script->map_stack);
 map_fail:
+    map_destroy(&script->symbol_map);
+symbol_map_fail:
+    map_destroy(&script->optional_map);
+optional_map_fail:
+    map_destroy(&script->code_map);
+code_map_fail:
+    store_destroy(&script->code_store);
+code_store_fail:
     store_destroy(&script->store);
 store_fail:
     scriptpstate_delete(script->parser);
@@ -433,15 +565,21 @@ parser_fail:
 }
 
 void script_destroy(struct script * script) {
+    table_link(script->table, NULL, NULL);
     undefined_destroy(&script->undefined);
     script_buffer_destroy(&script->buffer);
+    logic_table_destroy(&script->logic_table);
     map_destroy(&script->argument);
     map_destroy(&script->function);
     stack_destroy(&script->map_logic_stack);
     stack_destroy(&script->strbuf_stack);
-    stack_destroy(&script->stack_stack);
+    stack_destroy(&script->vector_stack);
     stack_destroy(&script->logic_stack);
     stack_destroy(&script->map_stack);
+    map_destroy(&script->symbol_map);
+    script_code_destroy(&script->optional_map);
+    script_code_destroy(&script->code_map);
+    store_destroy(&script->code_store);
     store_destroy(&script->store);
     scriptpstate_delete(script->parser);
     scriptlex_destroy(script->scanner);
@@ -449,30 +587,118 @@ void script_destroy(struct script * script) {
 
 int script_compile(struct script * script, char * string, struct strbuf * strbuf) {
     int status = 0;
+    size_t widen;
 
     strbuf_clear(strbuf);
 
     script->root = NULL;
     script->map = NULL;
     script->logic = NULL;
-    script->stack = NULL;
+    script->vector = NULL;
     script->strbuf = NULL;
     script->map_logic = NULL;
     script->range = NULL;
 
+    widen = script->logic_table.term_widen + script->logic_table.literal_widen;
+
     if(script_generate(script, string, strbuf))
         status = panic("failed to compile script object");
 
+    script->approximate = widen != script->logic_table.term_widen + script->logic_table.literal_widen;
     while(script->range) {
+        if(script->range->range->approximate)
+            script->approximate = 1;
         range_destroy(script->range->range);
         script->range = script->range->next;
     }
 
+    logic_table_clear(&script->logic_table);
     store_clear(&script->store);
 
     return status;
 }
 
+/*
+ * the BF_ and ATF_ flags and the constant groups are read
+ * from the constant table when the first script needs them
+ */
+int script_table_setup(struct script * script) {
+    int status = 0;
+
+    if(!script->setup) {
+        if(script_setup(script->table)) {
+            status = panic("failed to setup script object");
+        } else if(script_group_setup(script)) {
+            status = panic("failed to group setup script object");
+        } else {
+            script->setup = 1;
+        }
+    }
+
+    return status;
+}
+
+char * group_list[] = {
+    [group_element] = "element",
+    [group_equip] = "equip",
+    [group_job] = "job",
+    [group_size] = "size",
+    [group_race] = "race",
+    [group_mob_race] = "mob_race",
+    [group_effect] = "effect",
+    [group_class] = "class"
+};
+
+int script_group_setup(struct script * script) {
+    int i;
+
+    for(i = 0; i < group_count; i++) {
+        script->group[i] = constant_group_identifier(script->table, group_list[i]);
+        if(!script->group[i])
+            return panic("invalid constant group - %s", group_list[i]);
+    }
+
+    return 0;
+}
+
+/*
+ * bind the handler of each argument and the handler or
+ * argument of each print entry when the argument table
+ * is loaded so that a missing name fails the load
+ */
+int script_link(struct argument * argument, struct script * script) {
+    struct argument_node * node;
+    struct print_node * print;
+    struct entry_node * entry;
+
+    node = argument->argument;
+    while(node) {
+        node->callback = node->handler ? map_search(&script->argument, node->handler) : (void *) argument_print;
+        if(!node->callback)
+            return panic("invalid argument - %s", node->handler);
+
+        print = node->print;
+        while(print) {
+            entry = print->entry;
+            while(entry) {
+                if(entry->identifier) {
+                    entry->callback = map_search(&script->argument, entry->identifier);
+                    if(!entry->callback) {
+                        entry->argument = argument_identifier(script->table, entry->identifier);
+                        if(!entry->argument)
+                            return panic("undefined argument - %s", entry->identifier);
+                    }
+                }
+                entry = entry->next;
+            }
+            print = print->next;
+        }
+        node = node->next;
+    }
+
+    return 0;
+}
+
 int table_set_constant(struct table * table, char * identifier, long * result) {
     struct constant_node * constant;
 
@@ -525,7 +751,7 @@ int script_logic_push(struct script * script, struct logic * logic) {
             script->logic = logic;
         }
     } else {
-        if(logic_create(logic, script->heap->logic_pool)) {
+        if(logic_create(logic, &script->logic_table)) {
             status = panic("failed to create logic object");
         } else {
             if(logic_push(logic, or, NULL)) {
@@ -548,32 +774,32 @@ void script_logic_pop(struct script * script) {
     script->logic = stack_pop(&script->logic_stack);
 }
 
-int script_stack_push(struct script * script, struct stack * stack) {
+int script_vector_push(struct script * script, struct vector * vector) {
     int status = 0;
 
-    if(stack_create(stack, script->heap->stack_pool)) {
-        status = panic("failed to create stack object");
+    if(vector_create(vector)) {
+        status = panic("failed to create vector object");
     } else {
-        if(script->stack) {
-            if(stack_push(&script->stack_stack, script->stack)) {
+        if(script->vector) {
+            if(stack_push(&script->vector_stack, script->vector)) {
                 status = panic("failed to push stack object");
             } else {
-                script->stack = stack;
+                script->vector = vector;
             }
         } else {
-            script->stack = stack;
+            script->vector = vector;
         }
         if(status)
-            stack_destroy(stack);
+            vector_destroy(vector);
     }
 
     return status;
 }
 
-void script_stack_pop(struct script * script) {
-    stack_destroy(script->stack);
+void script_vector_pop(struct script * script) {
+    vector_destroy(script->vector);
 
-    script->stack = stack_pop(&script->stack_stack);
+    script->vector = stack_pop(&script->vector_stack);
 }
 
 int script_strbuf_push(struct script * script, struct strbuf * strbuf) {
@@ -636,6 +862,7 @@ struct script_range * script_range_create(struct script * script, enum script_ty
         status = panic("failed to object store object");
     } else {
         range->type = type;
+        range->temporary = 0;
         range->range = store_malloc(&script->store, sizeof(*range->range));
         if(!range->range) {
             status = panic("failed to object store object");
@@ -661,6 +888,112 @@ struct script_range * script_range_create(struct script * script, enum script_ty
     return status ? NULL : range;
 }
 
+int script_range_push(struct script * script, struct script_range * range) {
+    range->temporary = 0;
+
+    return vector_push(script->vector, range);
+}
+
+/*
+ * a temporary script range is owned by the expression that produced it
+ * and can be overwritten in place by the operator that consumes it
+ */
+int script_range_binary(struct script * script, struct script_range * x, struct script_range * y, range_cb cb, range_into_cb into, char * format, struct script_range ** result) {
+    int status = 0;
+    char * string;
+    struct script_range * range;
+
+    if(x->temporary && x != y) {
+        string = store_printf(&script->store, format, x->string, y->string);
+        if(!string) {
+            status = panic("failed to printf store object");
+        } else if(into(x->range, y->range)) {
+            status = panic("failed to into range object");
+        } else {
+            x->type = integer;
+            x->string = string;
+            *result = x;
+        }
+    } else {
+        range = script_range_create(script, integer, format, x->string, y->string);
+        if(!range) {
+            status = panic("failed to range script object");
+        } else if(cb(range->range, x->range, y->range)) {
+            status = panic("failed to cb range object");
+        } else {
+            range->temporary = 1;
+            *result = range;
+        }
+    }
+
+    return status;
+}
+
+int script_range_unary(struct script * script, struct script_range * x, range_unary_cb cb, range_unary_into_cb into, char * format, struct script_range ** result) {
+    int status = 0;
+    char * string;
+    struct script_range * range;
+
+    if(x->temporary) {
+        string = store_printf(&script->store, format, x->string);
+        if(!string) {
+            status = panic("failed to printf store object");
+        } else if(into(x->range)) {
+            status = panic("failed to into range object");
+        } else {
+            x->type = integer;
+            x->string = string;
+            *result = x;
+        }
+    } else {
+        range = script_range_create(script, integer, format, x->string);
+        if(!range) {
+            status = panic("failed to range script object");
+        } else if(cb(range->range, x->range)) {
+            status = panic("failed to cb range object");
+        } else {
+            range->temporary = 1;
+            *result = range;
+        }
+    }
+
+    return status;
+}
+
+int script_range_logic(struct script * script, struct script_range * x, struct script_range * y, char * format, struct script_range ** result) {
+    int status = 0;
+    char * string;
+    struct script_range * range;
+
+    if(x->temporary && x != y) {
+        string = store_printf(&script->store, format, x->string, y->string);
+        if(!string) {
+            status = panic("failed to printf store object");
+        } else {
+            range_clear(x->range);
+            if(range_add(x->range, 0, 1)) {
+                status = panic("failed to add range object");
+            } else {
+                x->type = integer;
+                x->string = string;
+                *result = x;
+            }
+        }
+    } else {
+        range = script_range_create(script, integer, format, x->string, y->string);
+        if(!range) {
+            status = panic("failed to range script object");
+        } else if(range_add(range->range, 0, 1)) {
+            status = panic("failed to add range object");
+        } else {
+            range->temporary = 1;
+            *result = range;
+        }
+    }
+
+    return status;
+}
+
 int script_logic_create(struct script * script, struct logic_node * root, struct map * result) {
     int status = 0;
 
@@ -671,7 +1004,7 @@ int script_logic_create(struct script * script, struct logic_node * root, struct
         status = panic("failed to create map object");
     } else {
         if(root->type == not || root->type == and) {
-            root = root->root;
+            root = root->term ? root->term->root : NULL;
             while(root && !status) {
                 if(root->type == cond) {
                     if(script_logic_cond(script, root->data, result, range_and))
@@ -758,6 +1091,7 @@ int script_generate(struct script * script, char * string, struct strbuf * strbu
     int status = 0;
 
     struct map map;
+    struct script_code * code;
 
     if(script_strbuf_push(script, strbuf)) {
         status = panic("failed to strbuf push script object");
@@ -765,10 +1099,10 @@ int script_generate(struct script * script, char * string, struct strbuf * strbu
         if(script_map_push(script, &map)) {
             status = panic("failed to map push script object");
         } else {
-            if(script_parse(script, string)) {
-                status = panic("failed to parse script object");
-            } else if(script_translate(script, script->root)) {
-                status = panic("failed to translate script object");
+            if(script_code(script, string, is_statement, &code)) {
+                status = panic("failed to code script object");
+            } else if(script_run(script, code, NULL)) {
+                status = panic("failed to run script object");
             }
             strbuf_trim(strbuf);
 
@@ -819,20 +1153,148 @@ int script_parse(struct script * script, char * string) {
     return status;
 }
 
-int script_translate(struct script * script, struct script_node * root) {
+/*
+ * scripts are cached by their source text so that a script
+ * shared by several items is only parsed and lowered once;
+ * the default of an optional argument is an expression and
+ * is cached apart from the scripts
+ */
+int script_code(struct script * script, char * string, int flag, struct script_code ** result) {
     int status = 0;
 
-    struct logic logic;
+    char * key;
+    struct map * map;
+    struct script_code * code;
+
+    map = (flag & is_statement) ? &script->code_map : &script->optional_map;
+
+    code = map_search(map, string);
+    if(!code) {
+        key = store_strcpy(&script->code_store, string, strlen(string));
+        if(!key) {
+            status = panic("failed to strcpy store object");
+        } else {
+            code = store_malloc(&script->code_store, sizeof(*code));
+            if(!code) {
+                status = panic("failed to malloc store object");
+            } else if(script_parse(script, string)) {
+                status = panic("failed to parse script object");
+            } else if(script_lower(script, code, &script->code_store, (flag & is_statement) ? script->root : script->root->root, flag)) {
+                status = panic("failed to lower script object");
+            } else if(map_insert(map, key, code)) {
+                status = panic("failed to insert map object");
+                free(code->op);
+            }
+        }
+    }
+
+    if(!status)
+        *result = code;
+
+    return status;
+}
+
+/*
+ * look up the function, statement and constant of flag in
+ * that order and stop at the first one that is found, the
+ * same order in which script_lower_expression uses them
+ */
+int script_symbol(struct script * script, char * identifier, int flag, struct script_symbol ** result) {
+    int status = 0;
+
+    struct script_symbol * symbol;
+
+    symbol = map_search(&script->symbol_map, identifier);
+    if(!symbol) {
+        symbol = store_calloc(&script->code_store, sizeof(*symbol));
+        if(!symbol) {
+            status = panic("failed to calloc store object");
+        } else {
+            symbol->identifier = store_strcpy(&script->code_store, identifier, strlen(identifier));
+            if(!symbol->identifier) {
+                status = panic("failed to strcpy store object");
+            } else if(map_insert(&script->symbol_map, symbol->identifier, symbol)) {
+                status = panic("failed to insert map object");
+            }
+        }
+    }
+
+    if(!status) {
+        if(flag & symbol_function) {
+            if(!(symbol->flag & symbol_function)) {
+                symbol->function = map_search(&script->function, identifier);
+                symbol->flag |= symbol_function;
+            }
+            if(symbol->function)
+                flag = 0;
+        }
+
+        if(flag & symbol_argument) {
+            if(!(symbol->flag & symbol_argument)) {
+                symbol->argument = statement_identifier(script->table, identifier);
+                symbol->flag |= symbol_argument;
+            }
+            if(symbol->argument)
+                flag = 0;
+        }
+
+        if(flag & symbol_constant) {
+            if(!(symbol->flag & symbol_constant)) {
+                symbol->constant = constant_identifier(script->table, identifier);
+                symbol->flag |= symbol_constant;
+            }
+        }
+
+        *result = symbol;
+    }
+
+    return status;
+}
+
+void script_code_destroy(struct map * map) {
+    struct script_code * code;
+
+    code = map_start(map).value;
+    while(code) {
+        free(code->op);
+        code = map_next(map).value;
+    }
+
+    map_destroy(map);
+}
+
+int script_lower(struct script * script, struct script_code * code, struct store * store, struct script_node * root, int flag) {
+    int status = 0;
+
+    code->op = NULL;
+    code->count = 0;
+    code->total = 0;
+
+    if(flag & is_statement) {
+        if(script_lower_statement(script, code, store, root))
+            status = panic("failed to lower statement script object");
+    } else {
+        if(script_lower_expression(script, code, store, root, flag))
+            status = panic("failed to lower expression script object");
+    }
+
+    if(status)
+        free(code->op);
+
+    return status;
+}
+
+int script_lower_statement(struct script * script, struct script_code * code, struct store * store, struct script_node * root) {
+    int status = 0;
 
     struct script_node * node;
-    struct script_range * range;
 
     switch(root->token) {
         case script_curly_open:
             node = root->root;
             while(node && !status) {
-                if(script_translate(script, node)) {
-                    status = panic("failed to statement script object");
+                if(script_lower_statement(script, code, store, node)) {
+                    status = panic("failed to lower statement script object");
                 } else {
                     node = node->next;
                 }
@@ -845,43 +1307,38 @@ int script_translate(struct script * script, struct script_node * root) {
             /* unsupport loop */
             break;
         case script_if:
-            if(script_logic_push(script, &logic)) {
-                status = panic("failed to logic push script object");
-            } else {
-                if(script_evaluate(script, root->root, is_logic, &range)) {
-                    status = panic("failed to expression script object");
-                } else if(script_translate_if(script, root->root->next, "[%s]\n", range->string)) {
-                    status = panic("failed to translate if script object");
-                }
-                script_logic_pop(script);
+            if(!script_emit(code, op_logic_push, 0)) {
+                status = panic("failed to emit script object");
+            } else if(script_lower_expression(script, code, store, root->root, is_logic)) {
+                status = panic("failed to lower expression script object");
+            } else if(script_lower_if(script, code, store, root->root->next, op_if_end)) {
+                status = panic("failed to lower if script object");
+            } else if(!script_emit(code, op_logic_pop, 0)) {
+                status = panic("failed to emit script object");
             }
             break;
         case script_else:
-            if(script_logic_push(script, &logic)) {
-                status = panic("failed to logic push script object");
-            } else {
-                if(logic_push(script->logic, not, NULL)) {
-                    status = panic("failed to logic top push script object");
-                } else if(logic_push(script->logic, or, NULL)) {
-                    status = panic("failed to logic top push script object");
-                } else if(script_evaluate(script, root->root, is_logic, &range)) {
-                    status = panic("failed to expression script object");
-                } else if(script_translate_if(script, root->root->next, "[%s]\n", range->string)) {
-                    status = panic("failed to translate if script object");
-                } else if(logic_pop(script->logic)) {
-                    status = panic("failed to logic top pop script object");
-                } else if(script_translate_if(script, root->root->next->next, "[else]\n")) {
-                    status = panic("failed to translate if script object");
-                }
-                script_logic_pop(script);
+            if( !script_emit(code, op_logic_push, 0) ||
+                !script_emit(code, op_logic_top_push, not) ||
+                !script_emit(code, op_logic_top_push, or) ) {
+                status = panic("failed to emit script object");
+            } else if(script_lower_expression(script, code, store, root->root, is_logic)) {
+                status = panic("failed to lower expression script object");
+            } else if(script_lower_if(script, code, store, root->root->next, op_if_end)) {
+                status = panic("failed to lower if script object");
+            } else if(!script_emit(code, op_logic_top_pop, 0)) {
+                status = panic("failed to emit script object");
+            } else if(script_lower_if(script, code, store, root->root->next->next, op_else_end)) {
+                status = panic("failed to lower if script object");
+            } else if(!script_emit(code, op_logic_pop, 0)) {
+                status = panic("failed to emit script object");
             }
             break;
         default:
-            if(script_evaluate(script, root, 0, &range)) {
-                status = panic("failed to expression script object");
-            } else if(range->type == identifier && root->token == script_identifier) {
-                if(strbuf_printf(script->strbuf, "%s\n", range->string))
-                    status = panic("failed to printf strbuf object");
+            if(script_lower_expression(script, code, store, root, 0)) {
+                status = panic("failed to lower expression script object");
+            } else if(!script_emit(code, op_statement, root->token == script_identifier)) {
+                status = panic("failed to emit script object");
             }
             break;
     }
@@ -889,919 +1346,978 @@ int script_translate(struct script * script, struct script_node * root) {
     return status;
 }
 
-int script_translate_if(struct script * script, struct script_node * root, char * format, ...) {
+int script_lower_if(struct script * script, struct script_code * code, struct store * store, struct script_node * root, int opcode) {
     int status = 0;
 
-    struct map map;
-
-    char * string;
-    va_list vararg;
-    struct strbuf * strbuf;
-
-    strbuf = script_buffer_get(&script->buffer);
-    if(!strbuf) {
-        status = panic("failed to get script buffer object");
-    } else {
-        if(script_strbuf_push(script, strbuf)) {
-            status = panic("failed to strbuf push script object");
-        } else {
-            if(script_map_logic_push(script, &map)) {
-                status = panic("failed to map logic push script object");
-            } else {
-                if(script_translate(script, root)) {
-                    status = panic("failed to translate script object");
-                } else {
-                    strbuf_trim(strbuf);
-                }
-                script_map_logic_pop(script);
-            }
-            script_strbuf_pop(script);
-        }
-
-        if(!status) {
-            string = strbuf_array(strbuf);
-            if(!string) {
-                status = panic("failed to array strbuf object");
-            } else if(*string) {
-                va_start(vararg, format);
-                if(strbuf_vprintf(script->strbuf, format, vararg)) {
-                    status = panic("failed to vprintf strbuf object");
-                } else if(strbuf_printf(script->strbuf, "%s\n", string)) {
-                    status = panic("failed to printf strbuf object");
-                }
-                va_end(vararg);
-            }
-        }
-
-        script_buffer_put(&script->buffer, strbuf);
+    if(!script_emit(code, op_if_begin, 0)) {
+        status = panic("failed to emit script object");
+    } else if(script_lower_statement(script, code, store, root)) {
+        status = panic("failed to lower statement script object");
+    } else if(!script_emit(code, opcode, 0)) {
+        status = panic("failed to emit script object");
     }
 
     return status;
 }
 
-int script_evaluate(struct script * script, struct script_node * root, int flag, struct script_range ** result) {
+int script_lower_expression(struct script * script, struct script_code * code, struct store * store, struct script_node * root, int flag) {
     int status = 0;
 
-    struct logic logic;
-    struct stack stack;
+    int comma;
+    size_t left;
+    size_t right;
+    struct script_op * op;
 
-    struct script_range * x;
-    struct script_range * y;
-    struct script_range * z;
-
-    struct script_range * range;
-    struct range_node * node;
-
-    function_cb function;
-    struct argument_node * argument;
-    struct constant_node * constant;
+    struct script_symbol * symbol;
 
     switch(root->token) {
         case script_integer:
-            range = script_range_create(script, integer, "%ld", root->integer);
-            if(!range) {
-                status = panic("failed to range script object");
-            } else if(range_add(range->range, root->integer, root->integer)) {
-                status = panic("failed to add range object");
+            op = script_emit(code, op_integer, flag);
+            if(!op) {
+                status = panic("failed to emit script object");
             } else {
-                *result = range;
+                op->integer = root->integer;
             }
             break;
         case script_identifier:
             if(root->root) {
-                if(script_stack_push(script, &stack)) {
-                    status = panic("failed to stack push script object");
+                if(!script_emit(code, op_vector_push, 0)) {
+                    status = panic("failed to emit script object");
+                } else if(script_lower_expression(script, code, store, root->root, flag | is_array)) {
+                    status = panic("failed to lower expression script object");
+                } else if(!script_emit(code, op_argument, 0)) {
+                    status = panic("failed to emit script object");
+                } else if(script_symbol(script, root->identifier, symbol_function | symbol_argument, &symbol)) {
+                    status = panic("failed to symbol script object");
                 } else {
-                    if(script_evaluate(script, root->root, flag | is_array, &x)) {
-                        status = panic("failed to evaluate script object");
-                    } else if(!stack_top(script->stack) && stack_push(script->stack, x)) {
-                        status = panic("failed to push stack object");
-                    } else {
-                        function = map_search(&script->function, root->identifier);
-                        if(function) {
-                            range = function(script, script->stack);
-                            if(!range) {
-                                status = panic("failed to function range script object");
-                            } else {
-                                *result = range;
-                            }
+                    if(symbol->function) {
+                        op = script_emit(code, op_function, flag);
+                        if(!op) {
+                            status = panic("failed to emit script object");
                         } else {
-                            argument = statement_identifier(script->table, root->identifier);
-                            if(argument) {
-                                range = script_execute(script, script->stack, argument);
-                                if(!range) {
-                                    status = panic("failed to execute script object");
-                                } else {
-                                    *result = range;
-                                }
-                            } else {
-                                if(undefined_add(&script->undefined, "statement.%s", root->identifier)) {
-                                    status = panic("failed to add undefined object");
-                                } else {
-                                    range = script_range_create(script, identifier, "%s", root->identifier);
-                                    if(!range) {
-                                        status = panic("failed to range script object");
-                                    } else {
-                                        *result = range;
-                                    }
-                                }
-                            }
+                            op->function = symbol->function;
                         }
-                    }
-                    script_stack_pop(script);
-                }
-            } else {
-                argument = statement_identifier(script->table, root->identifier);
-                if(argument) {
-                    range = script_execute(script, NULL, argument);
-                    if(!range) {
-                        status = panic("failed to execute script object");
-                    } else {
-                        *result = range;
-                    }
-                } else {
-                    constant = constant_identifier(script->table, root->identifier);
-                    if(constant) {
-                        range = script_range_create(script, constant->variable ? identifier : integer, "%s", constant->identifier);
-                        if(!range) {
-                            status = panic("failed to range script object");
+                    } else if(symbol->argument) {
+                        op = script_emit(code, op_call, flag);
+                        if(!op) {
+                            status = panic("failed to emit script object");
                         } else {
-                            if(constant->range) {
-                                node = constant->range;
-                                while(node && !status) {
-                                    if(range_add(range->range, node->min, node->max)) {
-                                        status = panic("failed to add range object");
-                                    } else {
-                                        node = node->next;
-                                    }
-                                }
-                            } else if(range_add(range->range, constant->value, constant->value)) {
-                                status = panic("failed to add range object");
-                            }
-
-                            *result = range;
+                            op->argument = symbol->argument;
                         }
                     } else {
-                        range = map_search(script->map, root->identifier);
-                        if(range) {
-                            *result = range;
+                        op = script_emit(code, op_undefined, flag);
+                        if(!op) {
+                            status = panic("failed to emit script object");
                         } else {
-                            range = script_range_create(script, identifier, "%s", root->identifier);
-                            if(!range) {
-                                status = panic("failed to range script object");
-                            } else {
-                                *result = range;
-                            }
-                        }
-
-                        /*
-                         * use variable identifier when concatenating a with string
-                         */
-                        if(flag & is_concat) {
-                            range = script_range_create(script, identifier, "%s", root->identifier);
-                            if(!range) {
-                                status = panic("failed to range script object");
-                            } else {
-                                *result = range;
-                            }
+                            op->identifier = symbol->identifier;
                         }
                     }
-                }
-            }
 
-            if(!status && script->map_logic) {
-                x = map_search(script->map_logic, range->string);
-                if(x) {
-                    y = script_range_create(script, range->type, "%s", range->string);
-                    if(!y) {
-                        status = panic("failed to range script object");
-                    } else if(range_and(y->range, x->range, range->range)) {
-                        status = panic("failed to and range object");
-                    } else {
-                        *result = y;
-                    }
+                    if(!status && !script_emit(code, op_vector_pop, 0))
+                        status = panic("failed to emit script object");
+                }
+            } else if(script_symbol(script, root->identifier, symbol_argument | symbol_constant, &symbol)) {
+                status = panic("failed to symbol script object");
+            } else if(symbol->argument) {
+                op = script_emit(code, op_execute, flag);
+                if(!op) {
+                    status = panic("failed to emit script object");
+                } else {
+                    op->argument = symbol->argument;
+                }
+            } else if(symbol->constant) {
+                op = script_emit(code, op_constant, flag);
+                if(!op) {
+                    status = panic("failed to emit script object");
+                } else {
+                    op->constant = symbol->constant;
+                }
+            } else {
+                op = script_emit(code, op_variable, flag);
+                if(!op) {
+                    status = panic("failed to emit script object");
+                } else {
+                    op->identifier = symbol->identifier;
                 }
             }
+
+            if(!status && !script_emit(code, op_map_logic, 0))
+                status = panic("failed to emit script object");
             break;
         case script_string:
-            range = script_range_create(script, string, "%s", root->identifier);
-            if(!range) {
-                status = panic("failed to range script object");
-            } else {
-                *result = range;
-            }
+            if(!script_emit_identifier(code, op_string, flag, store, root->identifier))
+                status = panic("failed to emit identifier script object");
             break;
         case script_comma:
-            if( script_evaluate(script, root->root, flag, &x) ||
-                script_evaluate(script, root->root->next, flag, &y) ) {
-                status = panic("failed to evaluate script object");
+            if( script_lower_expression(script, code, store, root->root, flag) ||
+                script_lower_expression(script, code, store, root->root->next, flag) ) {
+                status = panic("failed to lower expression script object");
             } else {
-                if(flag & is_array) {
-                    if(root->root->token == script_comma) {
-                        if(stack_push(script->stack, y))
-                            status = panic("failed to push stack object");
-                    } else if(root->root->next->token == script_comma) {
-                        if(stack_push(script->stack, x))
-                            status = panic("failed to push stack object");
-                    } else {
-                        if(stack_push(script->stack, x) || stack_push(script->stack, y))
-                            status = panic("failed to push stack object");
-                    }
+                if(!(flag & is_array)) {
+                    comma = 0;
+                } else if(root->root->token == script_comma) {
+                    comma = comma_y;
+                } else if(root->root->next->token == script_comma) {
+                    comma = comma_x;
+                } else {
+                    comma = comma_x | comma_y;
                 }
 
-                if(!status) {
-                    range = script_range_create(script, integer, "%s", y->string);
-                    if(!range) {
-                        status = panic("failed to range script object");
-                    } else if(range_assign(range->range, y->range)) {
-                        status = panic("failed to assign range object");
-                    } else {
-                        *result = range;
-                    }
-                }
+                if(!script_emit(code, op_comma, comma))
+                    status = panic("failed to emit script object");
             }
             break;
         case script_assign:
-            if( script_evaluate(script, root->root, flag, &x) ||
-                script_evaluate(script, root->root->next, flag, &y) ) {
-                status = panic("failed to evaluate script object");
-            } else {
-                range = script_range_create(script, identifier, "%s", y->string);
-                if(!range) {
-                    status = panic("failed to range script object");
-                } else if(range_assign(range->range, y->range)) {
-                    status = panic("failed to assign range object");
-                } else if(map_insert(script->map, x->string, range)) {
-                    status = panic("failed to map insert script object");
-                } else {
-                    *result = range;
-                }
-            }
+            if(script_lower_binary(script, code, store, root, flag, op_assign))
+                status = panic("failed to lower binary script object");
             break;
         case script_plus_assign:
-            if( script_evaluate(script, root->root, flag, &x) ||
-                script_evaluate(script, root->root->next, flag, &y) ) {
-                status = panic("failed to evaluate script object");
-            } else {
-                range = script_range_create(script, identifier, "%s", y->string);
-                if(!range) {
-                    status = panic("failed to range script object");
-                } else if(range_plus(range->range, x->range, y->range)) {
-                    status = panic("failed to plus range object");
-                } else if(map_insert(script->map, x->string, range)) {
-                    status = panic("failed to map insert script object");
-                } else {
-                    *result = range;
-                }
-            }
+            if(script_lower_binary(script, code, store, root, flag, op_plus_assign))
+                status = panic("failed to lower binary script object");
             break;
         case script_minus_assign:
-            if( script_evaluate(script, root->root, flag, &x) ||
-                script_evaluate(script, root->root->next, flag, &y) ) {
-                status = panic("failed to evaluate script object");
-            } else {
-                range = script_range_create(script, identifier, "%s", y->string);
-                if(!range) {
-                    status = panic("failed to range script object");
-                } else if(range_minus(range->range, x->range, y->range)) {
-                    status = panic("failed to minus range object");
-                } else if(map_insert(script->map, x->string, range)) {
-                    status = panic("failed to map insert script object");
-                } else {
-                    *result = range;
-                }
-            }
+            if(script_lower_binary(script, code, store, root, flag, op_minus_assign))
+                status = panic("failed to lower binary script object");
             break;
         case script_question:
-            if(script_logic_push(script, &logic)) {
-                status = panic("failed to logic push script object");
-            } else {
-                if(logic_push(script->logic, not, NULL)) {
-                    status = panic("failed to logic top push script object");
-                } else {
-                    if( script_evaluate(script, root->root, flag | is_logic, &x) ||
-                        script_evaluate(script, root->root->next, flag, &y) ) {
-                        status = panic("failed to evaluate script object");
-                    } else {
-                        range = script_range_create(script, integer, "%s ? %s", x->string, y->string);
-                        if(!range) {
-                            status = panic("failed to range script object");
-                        } else if(range_assign(range->range, y->range)) {
-                            status = panic("failed to assign range object");
-                        } else {
-                            *result = range;
-                        }
-                    }
-                }
-                script_logic_pop(script);
+            if( !script_emit(code, op_logic_push, 0) ||
+                !script_emit(code, op_logic_top_push, not) ) {
+                status = panic("failed to emit script object");
+            } else if( script_lower_expression(script, code, store, root->root, flag | is_logic) ||
+                       script_lower_expression(script, code, store, root->root->next, flag) ) {
+                status = panic("failed to lower expression script object");
+            } else if( !script_emit(code, op_question, flag) ||
+                       !script_emit(code, op_logic_pop, 0) ) {
+                status = panic("failed to emit script object");
             }
             break;
         case script_colon:
-            if(script_evaluate(script, root->root, flag, &x)) {
-                status = panic("failed to evaluate script object");
-            } else if(logic_pop(script->logic)) {
-                status = panic("failed to logic top pop script object");
-            } else if(script_evaluate(script, root->root->next, flag, &y)) {
-                status = panic("failed to evaluate script object");
-            } else {
-                range = script_range_create(script, integer, "%s : %s", x->string, y->string);
-                if(!range) {
-                    status = panic("failed to range script object");
-                } else if(range_or(range->range, x->range, y->range)) {
-                    status = panic("failed to or range object");
-                } else {
-                    *result = range;
-                }
+            if(script_lower_expression(script, code, store, root->root, flag)) {
+                status = panic("failed to lower expression script object");
+            } else if(!script_emit(code, op_logic_top_pop, 0)) {
+                status = panic("failed to emit script object");
+            } else if(script_lower_expression(script, code, store, root->root->next, flag)) {
+                status = panic("failed to lower expression script object");
+            } else if(!script_emit(code, op_colon, flag)) {
+                status = panic("failed to emit script object");
             }
             break;
         case script_bit_or:
-            if( script_evaluate(script, root->root, flag, &x) ||
-                script_evaluate(script, root->root->next, flag, &y) ) {
-                status = panic("failed to evaluate script object");
-            } else {
-                range = script_range_create(script, integer, "%s | %s", x->string, y->string);
-                if(!range) {
-                    status = panic("failed to range script object");
-                } else if(range_bit_or(range->range, x->range, y->range)) {
-                    status = panic("failed to bit or range object");
-                } else {
-                    *result = range;
-                }
-            }
+            if(script_lower_binary(script, code, store, root, flag, op_bit_or))
+                status = panic("failed to lower binary script object");
             break;
         case script_bit_xor:
-            if( script_evaluate(script, root->root, flag, &x) ||
-                script_evaluate(script, root->root->next, flag, &y) ) {
-                status = panic("failed to evaluate script object");
-            } else {
-                range = script_range_create(script, integer, "%s ^ %s", x->string, y->string);
-                if(!range) {
-                    status = panic("failed to range script object");
-                } else if(range_bit_xor(range->range, x->range, y->range)) {
-                    status = panic("failed to bit xor range object");
-                } else {
-                    *result = range;
-                }
-            }
+            if(script_lower_binary(script, code, store, root, flag, op_bit_xor))
+                status = panic("failed to lower binary script object");
             break;
         case script_bit_and:
-            if( script_evaluate(script, root->root, flag, &x) ||
-                script_evaluate(script, root->root->next, flag, &y) ) {
-                status = panic("failed to evaluate script object");
-            } else {
-                range = script_range_create(script, integer, "%s & %s", x->string, y->string);
-                if(!range) {
-                    status = panic("failed to range script object");
-                } else if(range_bit_and(range->range, x->range, y->range)) {
-                    status = panic("failed to bit and range object");
-                } else {
-                    *result = range;
-                }
-            }
+            if(script_lower_binary(script, code, store, root, flag, op_bit_and))
+                status = panic("failed to lower binary script object");
             break;
         case script_bit_left:
-            if( script_evaluate(script, root->root, flag, &x) ||
-                script_evaluate(script, root->root->next, flag, &y) ) {
-                status = panic("failed to evaluate script object");
-            } else {
-                range = script_range_create(script, integer, "%s << %s", x->string, y->string);
-                if(!range) {
-                    status = panic("failed to range script object");
-                } else if(range_bit_left(range->range, x->range, y->range)) {
-                    status = panic("failed to bit left range object");
-                } else {
-                    *result = range;
-                }
-            }
+            if(script_lower_binary(script, code, store, root, flag, op_bit_left))
+                status = panic("failed to lower binary script object");
             break;
         case script_bit_right:
-            if( script_evaluate(script, root->root, flag, &x) ||
-                script_evaluate(script, root->root->next, flag, &y) ) {
-                status = panic("failed to evaluate script object");
-            } else {
-                range = script_range_create(script, integer, "%s >> %s", x->string, y->string);
-                if(!range) {
-                    status = panic("failed to range script object");
-                } else if(range_bit_right(range->range, x->range, y->range)) {
-                    status = panic("failed to bit right range object");
-                } else {
-                    *result = range;
-                }
-            }
+            if(script_lower_binary(script, code, store, root, flag, op_bit_right))
+                status = panic("failed to lower binary script object");
             break;
         case script_plus:
-            if( script_evaluate(script, root->root, flag, &x) ||
-                script_evaluate(script, root->root->next, flag, &y) ) {
-                status = panic("failed to evaluate script object");
+            /*
+             * the concatenated operand is lowered a second time with
+             * is_concat and is only run when the other one is a string
+             */
+            if( script_lower_expression(script, code, store, root->root, flag) ||
+                script_lower_expression(script, code, store, root->root->next, flag) ) {
+                status = panic("failed to lower expression script object");
+            } else if(script_lower_concat(script, code, store, root->root->next, flag, op_plus_left, op_concat_left, &left)) {
+                status = panic("failed to lower concat script object");
+            } else if(script_lower_concat(script, code, store, root->root, flag, op_plus_right, op_concat_right, &right)) {
+                status = panic("failed to lower concat script object");
+            } else if(!script_emit(code, op_plus, flag)) {
+                status = panic("failed to emit script object");
             } else {
-                if(x->type == string) {
-                    if(script_evaluate(script, root->root->next, flag | is_concat, &z)) {
-                        status = panic("failed to evaluate script object");
-                    } else {
-                        range = script_range_create(script, integer, "%s%s", x->string, z->string);
-                        if(!range) {
-                            status = panic("failed to range script object");
-                        } else if(range_plus(range->range, x->range, y->range)) {
-                            status = panic("failed to plus range object");
-                        } else {
-                            *result = range;
-                        }
-                    }
-                } else if(y->type == string) {
-                    if(script_evaluate(script, root->root, flag | is_concat, &z)) {
-                        status = panic("failed to evaluate script object");
-                    } else {
-                        range = script_range_create(script, integer, "%s%s", z->string, y->string);
-                        if(!range) {
-                            status = panic("failed to range script object");
-                        } else if(range_plus(range->range, x->range, y->range)) {
-                            status = panic("failed to plus range object");
-                        } else {
-                            *result = range;
-                        }
-                    }
-                } else {
-                    range = script_range_create(script, integer, "%s + %s", x->string, y->string);
-                    if(!range) {
-                        status = panic("failed to range script object");
-                    } else if(range_plus(range->range, x->range, y->range)) {
-                        status = panic("failed to plus range object");
-                    } else {
-                        *result = range;
-                    }
-                }
+                code->op[left].jump = code->count;
+                code->op[right].jump = code->count;
             }
             break;
         case script_minus:
-            if( script_evaluate(script, root->root, flag, &x) ||
-                script_evaluate(script, root->root->next, flag, &y) ) {
-                status = panic("failed to evaluate script object");
-            } else {
-                range = script_range_create(script, integer, "%s - %s", x->string, y->string);
-                if(!range) {
-                    status = panic("failed to range script object");
-                } else if(range_minus(range->range, x->range, y->range)) {
-                    status = panic("failed to minus range object");
-                } else {
-                    *result = range;
-                }
-            }
+            if(script_lower_binary(script, code, store, root, flag, op_minus))
+                status = panic("failed to lower binary script object");
             break;
         case script_multiply:
-            if( script_evaluate(script, root->root, flag, &x) ||
-                script_evaluate(script, root->root->next, flag, &y) ) {
-                status = panic("failed to evaluate script object");
-            } else {
-                range = script_range_create(script, integer, "%s * %s", x->string, y->string);
-                if(!range) {
-                    status = panic("failed to range script object");
-                } else if(range_multiply(range->range, x->range, y->range)) {
-                    status = panic("failed to multiply range object");
-                } else {
-                    *result = range;
-                }
-            }
+            if(script_lower_binary(script, code, store, root, flag, op_multiply))
+                status = panic("failed to lower binary script object");
             break;
         case script_divide:
-            if( script_evaluate(script, root->root, flag, &x) ||
-                script_evaluate(script, root->root->next, flag, &y) ) {
-                status = panic("failed to evaluate script object");
-            } else {
-                range = script_range_create(script, integer, "%s / %s", x->string, y->string);
-                if(!range) {
-                    status = panic("failed to range script object");
-                } else if(range_divide(range->range, x->range, y->range)) {
-                    status = panic("failed to divide range object");
-                } else {
-                    *result = range;
-                }
-            }
+            if(script_lower_binary(script, code, store, root, flag, op_divide))
+                status = panic("failed to lower binary script object");
             break;
         case script_remainder:
-            if( script_evaluate(script, root->root, flag, &x) ||
-                script_evaluate(script, root->root->next, flag, &y) ) {
-                status = panic("failed to evaluate script object");
-            } else {
-                range = script_range_create(script, integer, "%s %% %s", x->string, y->string);
-                if(!range) {
-                    status = panic("failed to range script object");
-                } else if(range_remainder(range->range, x->range, y->range)) {
-                    status = panic("failed to remainder range object");
-                } else {
-                    *result = range;
-                }
-            }
+            if(script_lower_binary(script, code, store, root, flag, op_remainder))
+                status = panic("failed to lower binary script object");
             break;
         case script_plus_unary:
-            if(script_evaluate(script, root->root, flag, &x)) {
-                status = panic("failed to evaluate script object");
-            } else {
-                range = script_range_create(script, integer, "+ %s", x->string);
-                if(!range) {
-                    status = panic("failed to range script object");
-                } else if(range_plus_unary(range->range, x->range)) {
-                    status = panic("failed to plus unary range object");
-                } else {
-                    *result = range;
-                }
-            }
+            if(script_lower_unary(script, code, store, root, flag, op_plus_unary))
+                status = panic("failed to lower unary script object");
             break;
         case script_minus_unary:
-            if(script_evaluate(script, root->root, flag, &x)) {
-                status = panic("failed to evaluate script object");
-            } else {
-                range = script_range_create(script, integer, "- %s", x->string);
-                if(!range) {
-                    status = panic("failed to range script object");
-                } else if(range_minus_unary(range->range, x->range)) {
-                    status = panic("failed to minus unary range object");
-                } else {
-                    *result = range;
-                }
-            }
+            if(script_lower_unary(script, code, store, root, flag, op_minus_unary))
+                status = panic("failed to lower unary script object");
             break;
         case script_bit_not:
-            if(script_evaluate(script, root->root, flag, &x)) {
-                status = panic("failed to evaluate script object");
-            } else {
-                range = script_range_create(script, integer, "~ %s", x->string);
-                if(!range) {
-                    status = panic("failed to range script object");
-                } else if(range_bit_not(range->range, x->range)) {
-                    status = panic("failed to bit not range object");
-                } else {
-                    *result = range;
-                }
-            }
+            if(script_lower_unary(script, code, store, root, flag, op_bit_not))
+                status = panic("failed to lower unary script object");
             break;
         case script_increment_prefix:
         case script_increment_postfix:
-            if(script_evaluate(script, root->root, flag, &x)) {
-                status = panic("failed to evaluate script object");
-            } else {
-                range = script_range_create(script, integer, "%s ++", x->string);
-                if(!range) {
-                    status = panic("failed to range script object");
-                } else if(range_increment(range->range, x->range)) {
-                    status = panic("failed to increment range object");
-                } else {
-                    *result = range;
-                }
-            }
+            if(script_lower_unary(script, code, store, root, flag, op_increment))
+                status = panic("failed to lower unary script object");
             break;
         case script_decrement_prefix:
         case script_decrement_postfix:
-            if(script_evaluate(script, root->root, flag, &x)) {
-                status = panic("failed to evaluate script object");
-            } else {
-                range = script_range_create(script, integer, "%s --", x->string);
-                if(!range) {
-                    status = panic("failed to range script object");
-                } else if(range_decrement(range->range, x->range)) {
-                    status = panic("failed to decrement range object");
-                } else {
-                    *result = range;
-                }
-            }
+            if(script_lower_unary(script, code, store, root, flag, op_decrement))
+                status = panic("failed to lower unary script object");
             break;
         case script_or:
-            if(flag & is_logic) {
-                if(logic_push(script->logic, or, NULL)) {
-                    status = panic("failed to logic top push script object");
-                } else {
-                    if( script_evaluate(script, root->root, flag, &x) ||
-                        script_evaluate(script, root->root->next, flag, &y) ) {
-                        status = panic("failed to evaluate script object");
-                    } else if(logic_pop(script->logic)) {
-                        status = panic("failed to logic top pop script object");
-                    }
-                }
+            if(script_lower_logic(script, code, store, root, flag, or, op_or))
+                status = panic("failed to lower logic script object");
+            break;
+        case script_and:
+            if(script_lower_logic(script, code, store, root, flag, and, op_and))
+                status = panic("failed to lower logic script object");
+            break;
+        case script_not:
+            if(script_lower_logic(script, code, store, root, flag, not, op_not))
+                status = panic("failed to lower logic script object");
+            break;
+        case script_equal:
+            if(script_lower_binary(script, code, store, root, flag, op_equal))
+                status = panic("failed to lower binary script object");
+            break;
+        case script_not_equal:
+            if(script_lower_binary(script, code, store, root, flag, op_not_equal))
+                status = panic("failed to lower binary script object");
+            break;
+        case script_lesser:
+            if(script_lower_binary(script, code, store, root, flag, op_lesser))
+                status = panic("failed to lower binary script object");
+            break;
+        case script_lesser_equal:
+            if(script_lower_binary(script, code, store, root, flag, op_lesser_equal))
+                status = panic("failed to lower binary script object");
+            break;
+        case script_greater:
+            if(script_lower_binary(script, code, store, root, flag, op_greater))
+                status = panic("failed to lower binary script object");
+            break;
+        case script_greater_equal:
+            if(script_lower_binary(script, code, store, root, flag, op_greater_equal))
+                status = panic("failed to lower binary script object");
+            break;
+        default:
+            status = panic("invalid token - %d", root->token);
+            break;
+    }
+
+    return status;
+}
+
+int script_lower_unary(struct script * script, struct script_code * code, struct store * store, struct script_node * root, int flag, int opcode) {
+    int status = 0;
+
+    if(script_lower_expression(script, code, store, root->root, flag)) {
+        status = panic("failed to lower expression script object");
+    } else if(!script_emit(code, opcode, flag)) {
+        status = panic("failed to emit script object");
+    }
+
+    return status;
+}
+
+int script_lower_binary(struct script * script, struct script_code * code, struct store * store, struct script_node * root, int flag, int opcode) {
+    int status = 0;
+
+    if( script_lower_expression(script, code, store, root->root, flag) ||
+        script_lower_expression(script, code, store, root->root->next, flag) ) {
+        status = panic("failed to lower expression script object");
+    } else if(!script_emit(code, opcode, flag)) {
+        status = panic("failed to emit script object");
+    }
+
+    return status;
+}
+
+/*
+ * the operands of a logic operator are only pushed
+ * onto the logic object when the result is a condition
+ */
+int script_lower_logic(struct script * script, struct script_code * code, struct store * store, struct script_node * root, int flag, int type, int opcode) {
+    int status = 0;
+
+    struct script_node * node;
+
+    if((flag & is_logic) && !script_emit(code, op_logic_top_push, type)) {
+        status = panic("failed to emit script object");
+    } else {
+        node = root->root;
+        while(node && !status) {
+            if(script_lower_expression(script, code, store, node, flag)) {
+                status = panic("failed to lower expression script object");
             } else {
-                if( script_evaluate(script, root->root, flag, &x) ||
-                    script_evaluate(script, root->root->next, flag, &y) )
-                    status = panic("failed to evaluate script object");
+                node = node->next;
             }
+        }
+
+        if(status) {
+            /* skip on error */
+        } else if((flag & is_logic) && !script_emit(code, op_logic_top_pop, 0)) {
+            status = panic("failed to emit script object");
+        } else if(!script_emit(code, opcode, flag)) {
+            status = panic("failed to emit script object");
+        }
+    }
+
+    return status;
+}
+
+int script_lower_concat(struct script * script, struct script_code * code, struct store * store, struct script_node * root, int flag, int test, int concat, size_t * result) {
+    int status = 0;
+
+    size_t index;
+
+    index = code->count;
+    if(!script_emit(code, test, flag)) {
+        status = panic("failed to emit script object");
+    } else if(script_lower_expression(script, code, store, root, flag | is_concat)) {
+        status = panic("failed to lower expression script object");
+    } else if(!script_emit(code, concat, flag)) {
+        status = panic("failed to emit script object");
+    } else {
+        code->op[index].jump = code->count;
+        *result = code->count - 1;
+    }
+
+    return status;
+}
+
+struct script_op * script_emit(struct script_code * code, int opcode, int flag) {
+    int status = 0;
+
+    size_t total;
+    struct script_op * op;
+
+    if(code->count >= code->total) {
+        total = code->total ? code->total * 2 : SCRIPT_CODE_SIZE;
+        op = realloc(code->op, total * sizeof(*op));
+        if(!op) {
+            status = panic("out of memory");
+        } else {
+            code->op = op;
+            code->total = total;
+        }
+    }
 
-            if(!status) {
-                range = script_range_create(script, integer, "%s || %s", x->string, y->string);
-                if(!range) {
-                    status = panic("failed to range script object");
-                } else if(range_add(range->range, 0, 1)) {
-                    status = panic("failed to add range object");
-                } else {
-                    *result = range;
-                }
-            }
-            break;
-        case script_and:
-            if(flag & is_logic) {
-                if(logic_push(script->logic, and, NULL)) {
-                    status = panic("failed to logic top push script object");
-                } else {
-                    if( script_evaluate(script, root->root, flag, &x) ||
-                        script_evaluate(script, root->root->next, flag, &y) ) {
-                        status = panic("failed to evaluate script object");
-                    } else if(logic_pop(script->logic)) {
-                        status = panic("failed to logic top pop script object");
-                    }
-                }
-            } else {
-                if( script_evaluate(script, root->root, flag, &x) ||
-                    script_evaluate(script, root->root->next, flag, &y) )
-                    status = panic("failed to evaluate script object");
-            }
+    if(!status) {
+        op = &code->op[code->count++];
+        op->opcode = opcode;
+        op->flag = flag;
+        op->jump = 0;
+        op->integer = 0;
+    }
 
-            if(!status) {
-                range = script_range_create(script, integer, "%s && %s", x->string, y->string);
-                if(!range) {
-                    status = panic("failed to range script object");
-                } else if(range_add(range->range, 0, 1)) {
-                    status = panic("failed to add range object");
-                } else {
-                    *result = range;
-                }
-            }
-            break;
-        case script_not:
-            if(flag & is_logic) {
-                if(logic_push(script->logic, not, NULL)) {
-                    status = panic("failed to logic top push script object");
-                } else if(script_evaluate(script, root->root, flag, &x)) {
-                    status = panic("failed to evaluate script object");
-                } else if(logic_pop(script->logic)) {
-                    status = panic("failed to logic top pop script object");
-                }
-            } else {
-                if(script_evaluate(script, root->root, flag, &x))
-                    status = panic("failed to evaluate script object");
-            }
+    return status ? NULL : op;
+}
 
-            if(!status) {
-                range = script_range_create(script, integer, "! %s", x->string);
-                if(!range) {
-                    status = panic("failed to range script object");
-                } else if(range_add(range->range, 0, 1)) {
-                    status = panic("failed to add range object");
-                } else {
-                    *result = range;
-                }
-            }
-            break;
-        case script_equal:
-            if( script_evaluate(script, root->root, flag, &x) ||
-                script_evaluate(script, root->root->next, flag, &y) ) {
-                status = panic("failed to evaluate script object");
-            } else {
-                if(flag & is_logic) {
-                    if(x->type == identifier) {
-                        range = script_range_create(script, identifier, "%s", x->string);
-                        if(!range) {
-                            status = panic("failed to range script object");
-                        } else if(range_equal(range->range, x->range, y->range)) {
-                            status = panic("failed to equal range object");
-                        } else if(logic_push(script->logic, cond, range)) {
-                            status = panic("failed to logic top push script object");
-                        }
-                    }
+struct script_op * script_emit_identifier(struct script_code * code, int opcode, int flag, struct store * store, char * identifier) {
+    int status = 0;
 
-                    if(y->type == identifier && !status) {
-                        range = script_range_create(script, identifier, "%s", y->string);
-                        if(!range) {
-                            status = panic("failed to range script object");
-                        } else if(range_equal(range->range, y->range, x->range)) {
-                            status = panic("failed to equal range object");
-                        } else if(logic_push(script->logic, cond, range)) {
-                            status = panic("failed to logic top push script object");
-                        }
-                    }
-                }
+    struct script_op * op;
+
+    op = script_emit(code, opcode, flag);
+    if(!op) {
+        status = panic("failed to emit script object");
+    } else {
+        op->identifier = store_strcpy(store, identifier, strlen(identifier));
+        if(!op->identifier)
+            status = panic("failed to strcpy store object");
+    }
+
+    return status ? NULL : op;
+}
 
-                if(!status) {
-                    range = script_range_create(script, integer, "%s == %s", x->string, y->string);
+int script_run(struct script * script, struct script_code * code, struct script_range ** result) {
+    int status = 0;
+
+    size_t pc;
+    struct script_op * op;
+    struct vector stack;
+    struct script_frame * frame;
+    struct script_frame * next;
+
+    struct script_range * x;
+    struct script_range * y;
+    struct script_range * z;
+
+    struct script_range * range;
+    struct range_node * node;
+
+    struct constant_node * constant;
+
+    if(vector_create(&stack)) {
+        status = panic("failed to create vector object");
+    } else {
+        pc = 0;
+        frame = NULL;
+        while(pc < code->count && !status) {
+            op = &code->op[pc++];
+            range = NULL;
+
+            switch(op->opcode) {
+                case op_integer:
+                    range = script_range_create(script, integer, "%ld", op->integer);
                     if(!range) {
                         status = panic("failed to range script object");
-                    } else if(range_add(range->range, 0, 1)) {
+                    } else if(range_add(range->range, op->integer, op->integer)) {
                         status = panic("failed to add range object");
                     } else {
-                        *result = range;
-                    }
-                }
-            }
-            break;
-        case script_not_equal:
-            if( script_evaluate(script, root->root, flag, &x) ||
-                script_evaluate(script, root->root->next, flag, &y) ) {
-                status = panic("failed to evaluate script object");
-            } else {
-                if(flag & is_logic) {
-                    if(x->type == identifier) {
-                        range = script_range_create(script, identifier, "%s", x->string);
-                        if(!range) {
-                            status = panic("failed to range script object");
-                        } else if(range_not_equal(range->range, x->range, y->range)) {
-                            status = panic("failed to not equal range object");
-                        } else if(logic_push(script->logic, cond, range)) {
-                            status = panic("failed to logic top push script object");
-                        }
+                        range->temporary = 1;
                     }
-
-                    if(y->type == identifier && !status) {
-                        range = script_range_create(script, identifier, "%s", y->string);
-                        if(!range) {
+                    break;
+                case op_string:
+                    range = script_range_create(script, string, "%s", op->identifier);
+                    if(!range)
+                        status = panic("failed to range script object");
+                    break;
+                case op_variable:
+                    /*
+                     * use variable identifier when concatenating a with string
+                     */
+                    range = map_search(script->map, op->identifier);
+                    if(!range || (op->flag & is_concat)) {
+                        range = script_range_create(script, identifier, "%s", op->identifier);
+                        if(!range)
                             status = panic("failed to range script object");
-                        } else if(range_not_equal(range->range, y->range, x->range)) {
-                            status = panic("failed to not equal range object");
-                        } else if(logic_push(script->logic, cond, range)) {
-                            status = panic("failed to logic top push script object");
-                        }
                     }
-                }
-
-                if(!status) {
-                    range = script_range_create(script, integer, "%s != %s", x->string, y->string);
+                    break;
+                case op_constant:
+                    constant = op->constant;
+                    range = script_range_create(script, constant->variable ? identifier : integer, "%s", constant->identifier);
                     if(!range) {
                         status = panic("failed to range script object");
-                    } else if(range_add(range->range, 0, 1)) {
-                        status = panic("failed to add range object");
                     } else {
-                        *result = range;
-                    }
-                }
-            }
-            break;
-        case script_lesser:
-            if( script_evaluate(script, root->root, flag, &x) ||
-                script_evaluate(script, root->root->next, flag, &y) ) {
-                status = panic("failed to evaluate script object");
-            } else {
-                if(flag & is_logic) {
-                    if(x->type == identifier) {
-                        range = script_range_create(script, identifier, "%s", x->string);
-                        if(!range) {
-                            status = panic("failed to range script object");
-                        } else if(range_lesser(range->range, x->range, y->range)) {
-                            status = panic("failed to lesser range object");
-                        } else if(logic_push(script->logic, cond, range)) {
-                            status = panic("failed to logic top push script object");
+                        if(constant->range) {
+                            node = constant->range;
+                            while(node && !status) {
+                                if(range_add(range->range, node->min, node->max)) {
+                                    status = panic("failed to add range object");
+                                } else {
+                                    node = node->next;
+                                }
+                            }
+                        } else if(range_add(range->range, constant->value, constant->value)) {
+                            status = panic("failed to add range object");
                         }
-                    }
 
-                    if(y->type == identifier && !status) {
-                        range = script_range_create(script, identifier, "%s", y->string);
-                        if(!range) {
-                            status = panic("failed to range script object");
-                        } else if(range_greater(range->range, y->range, x->range)) {
-                            status = panic("failed to greater range object");
-                        } else if(logic_push(script->logic, cond, range)) {
-                            status = panic("failed to logic top push script object");
-                        }
+                        range->temporary = 1;
                     }
-                }
-
-                if(!status) {
-                    range = script_range_create(script, integer, "%s < %s", x->string, y->string);
-                    if(!range) {
-                        status = panic("failed to range script object");
-                    } else if(range_add(range->range, 0, 1)) {
-                        status = panic("failed to add range object");
+                    break;
+                case op_execute:
+                    range = script_execute(script, NULL, op->argument);
+                    if(!range)
+                        status = panic("failed to execute script object");
+                    break;
+                case op_vector_push:
+                case op_logic_push:
+                case op_if_begin:
+                    next = script_frame_push(script, frame, op->opcode);
+                    if(!next) {
+                        status = panic("failed to frame push script object");
                     } else {
-                        *result = range;
+                        frame = next;
                     }
-                }
-            }
-            break;
-        case script_lesser_equal:
-            if( script_evaluate(script, root->root, flag, &x) ||
-                script_evaluate(script, root->root->next, flag, &y) ) {
-                status = panic("failed to evaluate script object");
-            } else {
-                if(flag & is_logic) {
-                    if(x->type == identifier) {
-                        range = script_range_create(script, identifier, "%s", x->string);
-                        if(!range) {
+                    break;
+                case op_argument:
+                    x = vector_pop(&stack);
+                    if(!vector_top(script->vector) && script_range_push(script, x))
+                        status = panic("failed to push script range object");
+                    break;
+                case op_function:
+                    range = ((function_cb) op->function)(script, script->vector);
+                    if(!range)
+                        status = panic("failed to function range script object");
+                    break;
+                case op_call:
+                    range = script_execute(script, script->vector, op->argument);
+                    if(!range)
+                        status = panic("failed to execute script object");
+                    break;
+                case op_undefined:
+                    if(undefined_add(&script->undefined, "statement.%s", op->identifier)) {
+                        status = panic("failed to add undefined object");
+                    } else {
+                        range = script_range_create(script, identifier, "%s", op->identifier);
+                        if(!range)
                             status = panic("failed to range script object");
-                        } else if(range_lesser_equal(range->range, x->range, y->range)) {
-                            status = panic("failed to lesser equal range object");
-                        } else if(logic_push(script->logic, cond, range)) {
-                            status = panic("failed to logic top push script object");
+                    }
+                    break;
+                case op_vector_pop:
+                case op_logic_pop:
+                    frame = script_frame_pop(script, frame);
+                    break;
+                case op_map_logic:
+                    if(script->map_logic) {
+                        x = vector_top(&stack);
+                        y = map_search(script->map_logic, x->string);
+                        if(y) {
+                            range = script_range_create(script, x->type, "%s", x->string);
+                            if(!range) {
+                                status = panic("failed to range script object");
+                            } else if(range_and(range->range, y->range, x->range)) {
+                                status = panic("failed to and range object");
+                            } else {
+                                vector_pop(&stack);
+                            }
                         }
                     }
-
-                    if(y->type == identifier && !status) {
-                        range = script_range_create(script, identifier, "%s", y->string);
+                    break;
+                case op_comma:
+                    y = vector_pop(&stack);
+                    x = vector_pop(&stack);
+                    if((op->flag & comma_x) && script_range_push(script, x)) {
+                        status = panic("failed to push script range object");
+                    } else if((op->flag & comma_y) && script_range_push(script, y)) {
+                        status = panic("failed to push script range object");
+                    } else if(y->temporary) {
+                        y->type = integer;
+                        range = y;
+                    } else {
+                        range = script_range_create(script, integer, "%s", y->string);
                         if(!range) {
                             status = panic("failed to range script object");
-                        } else if(range_greater_equal(range->range, y->range, x->range)) {
-                            status = panic("failed to greater equal range object");
-                        } else if(logic_push(script->logic, cond, range)) {
-                            status = panic("failed to logic top push script object");
+                        } else if(range_assign(range->range, y->range)) {
+                            status = panic("failed to assign range object");
+                        } else {
+                            range->temporary = 1;
                         }
                     }
-                }
-
-                if(!status) {
-                    range = script_range_create(script, integer, "%s <= %s", x->string, y->string);
+                    break;
+                case op_assign:
+                    y = vector_pop(&stack);
+                    x = vector_pop(&stack);
+                    range = script_range_create(script, identifier, "%s", y->string);
                     if(!range) {
                         status = panic("failed to range script object");
-                    } else if(range_add(range->range, 0, 1)) {
-                        status = panic("failed to add range object");
-                    } else {
-                        *result = range;
+                    } else if(y->temporary ? range_assign_move(range->range, y->range) : range_assign(range->range, y->range)) {
+                        status = panic("failed to assign range object");
+                    } else if(map_insert(script->map, x->string, range)) {
+                        status = panic("failed to map insert script object");
                     }
-                }
-            }
-            break;
-        case script_greater:
-            if( script_evaluate(script, root->root, flag, &x) ||
-                script_evaluate(script, root->root->next, flag, &y) ) {
-                status = panic("failed to evaluate script object");
-            } else {
-                if(flag & is_logic) {
-                    if(x->type == identifier) {
-                        range = script_range_create(script, identifier, "%s", x->string);
-                        if(!range) {
-                            status = panic("failed to range script object");
-                        } else if(range_greater(range->range, x->range, y->range)) {
-                            status = panic("failed to greater range object");
-                        } else if(logic_push(script->logic, cond, range)) {
-                            status = panic("failed to logic top push script object");
-                        }
+                    break;
+                case op_plus_assign:
+                    y = vector_pop(&stack);
+                    x = vector_pop(&stack);
+                    range = script_range_create(script, identifier, "%s", y->string);
+                    if(!range) {
+                        status = panic("failed to range script object");
+                    } else if(range_plus(range->range, x->range, y->range)) {
+                        status = panic("failed to plus range object");
+                    } else if(map_insert(script->map, x->string, range)) {
+                        status = panic("failed to map insert script object");
                     }
-
-                    if(y->type == identifier && !status) {
-                        range = script_range_create(script, identifier, "%s", y->string);
-                        if(!range) {
-                            status = panic("failed to range script object");
-                        } else if(range_lesser(range->range, y->range, x->range)) {
-                            status = panic("failed to lesser range object");
-                        } else if(logic_push(script->logic, cond, range)) {
-                            status = panic("failed to logic top push script object");
-                        }
+                    break;
+                case op_minus_assign:
+                    y = vector_pop(&stack);
+                    x = vector_pop(&stack);
+                    range = script_range_create(script, identifier, "%s", y->string);
+                    if(!range) {
+                        status = panic("failed to range script object");
+                    } else if(range_minus(range->range, x->range, y->range)) {
+                        status = panic("failed to minus range object");
+                    } else if(map_insert(script->map, x->string, range)) {
+                        status = panic("failed to map insert script object");
                     }
-                }
-
-                if(!status) {
-                    range = script_range_create(script, integer, "%s > %s", x->string, y->string);
+                    break;
+                case op_logic_top_push:
+                    if(logic_push(script->logic, op->flag, NULL))
+                        status = panic("failed to logic top push script object");
+                    break;
+                case op_logic_top_pop:
+                    if(logic_pop(script->logic))
+                        status = panic("failed to logic top pop script object");
+                    break;
+                case op_question:
+                    y = vector_pop(&stack);
+                    x = vector_pop(&stack);
+                    range = script_range_create(script, integer, "%s ? %s", x->string, y->string);
                     if(!range) {
                         status = panic("failed to range script object");
-                    } else if(range_add(range->range, 0, 1)) {
-                        status = panic("failed to add range object");
+                    } else if(y->temporary ? range_assign_move(range->range, y->range) : range_assign(range->range, y->range)) {
+                        status = panic("failed to assign range object");
                     } else {
-                        *result = range;
+                        range->temporary = 1;
                     }
-                }
-            }
-            break;
-        case script_greater_equal:
-            if( script_evaluate(script, root->root, flag, &x) ||
-                script_evaluate(script, root->root->next, flag, &y) ) {
-                status = panic("failed to evaluate script object");
-            } else {
-                if(flag & is_logic) {
-                    if(x->type == identifier) {
-                        range = script_range_create(script, identifier, "%s", x->string);
-                        if(!range) {
-                            status = panic("failed to range script object");
-                        } else if(range_greater_equal(range->range, x->range, y->range)) {
-                            status = panic("failed to greater equal range object");
-                        } else if(logic_push(script->logic, cond, range)) {
-                            status = panic("failed to logic top push script object");
-                        }
+                    break;
+                case op_colon:
+                    y = vector_pop(&stack);
+                    x = vector_pop(&stack);
+                    if(script_range_binary(script, x, y, range_or, range_or_into, "%s : %s", &range))
+                        status = panic("failed to or range object");
+                    break;
+                case op_bit_or:
+                    y = vector_pop(&stack);
+                    x = vector_pop(&stack);
+                    if(script_range_binary(script, x, y, range_bit_or, range_bit_or_into, "%s | %s", &range))
+                        status = panic("failed to bit or range object");
+                    break;
+                case op_bit_xor:
+                    y = vector_pop(&stack);
+                    x = vector_pop(&stack);
+                    if(script_range_binary(script, x, y, range_bit_xor, range_bit_xor_into, "%s ^ %s", &range))
+                        status = panic("failed to bit xor range object");
+                    break;
+                case op_bit_and:
+                    y = vector_pop(&stack);
+                    x = vector_pop(&stack);
+                    if(script_range_binary(script, x, y, range_bit_and, range_bit_and_into, "%s & %s", &range))
+                        status = panic("failed to bit and range object");
+                    break;
+                case op_bit_left:
+                    y = vector_pop(&stack);
+                    x = vector_pop(&stack);
+                    if(script_range_binary(script, x, y, range_bit_left, range_bit_left_into, "%s << %s", &range))
+                        status = panic("failed to bit left range object");
+                    break;
+                case op_bit_right:
+                    y = vector_pop(&stack);
+                    x = vector_pop(&stack);
+                    if(script_range_binary(script, x, y, range_bit_right, range_bit_right_into, "%s >> %s", &range))
+                        status = panic("failed to bit right range object");
+                    break;
+                case op_plus_left:
+                    x = vector_get(&stack, stack.count - 2);
+                    if(x->type != string)
+                        pc = op->jump;
+                    break;
+                case op_concat_left:
+                    z = vector_pop(&stack);
+                    y = vector_pop(&stack);
+                    x = vector_pop(&stack);
+                    range = script_range_create(script, integer, "%s%s", x->string, z->string);
+                    if(!range) {
+                        status = panic("failed to range script object");
+                    } else if(range_plus(range->range, x->range, y->range)) {
+                        status = panic("failed to plus range object");
+                    } else {
+                        pc = op->jump;
                     }
-
-                    if(y->type == identifier && !status) {
-                        range = script_range_create(script, identifier, "%s", y->string);
-                        if(!range) {
-                            status = panic("failed to range script object");
-                        } else if(range_lesser_equal(range->range, y->range, x->range)) {
-                            status = panic("failed to lesser equal range object");
-                        } else if(logic_push(script->logic, cond, range)) {
-                            status = panic("failed to logic top push script object");
-                        }
+                    break;
+                case op_plus_right:
+                    y = vector_top(&stack);
+                    if(y->type != string)
+                        pc = op->jump;
+                    break;
+                case op_concat_right:
+                    z = vector_pop(&stack);
+                    y = vector_pop(&stack);
+                    x = vector_pop(&stack);
+                    range = script_range_create(script, integer, "%s%s", z->string, y->string);
+                    if(!range) {
+                        status = panic("failed to range script object");
+                    } else if(range_plus(range->range, x->range, y->range)) {
+                        status = panic("failed to plus range object");
+                    } else {
+                        pc = op->jump;
                     }
-                }
-
-                if(!status) {
-                    range = script_range_create(script, integer, "%s >= %s", x->string, y->string);
+                    break;
+                case op_plus:
+                    y = vector_pop(&stack);
+                    x = vector_pop(&stack);
+                    if(script_range_binary(script, x, y, range_plus, range_plus_into, "%s + %s", &range))
+                        status = panic("failed to plus range object");
+                    break;
+                case op_minus:
+                    y = vector_pop(&stack);
+                    x = vector_pop(&stack);
+                    if(script_range_binary(script, x, y, range_minus, range_minus_into, "%s - %s", &range))
+                        status = panic("failed to minus range object");
+                    break;
+                case op_multiply:
+                    y = vector_pop(&stack);
+                    x = vector_pop(&stack);
+                    if(script_range_binary(script, x, y, range_multiply, range_multiply_into, "%s * %s", &range))
+                        status = panic("failed to multiply range object");
+                    break;
+                case op_divide:
+                    y = vector_pop(&stack);
+                    x = vector_pop(&stack);
+                    if(script_range_binary(script, x, y, range_divide, range_divide_into, "%s / %s", &range))
+                        status = panic("failed to divide range object");
+                    break;
+                case op_remainder:
+                    y = vector_pop(&stack);
+                    x = vector_pop(&stack);
+                    if(script_range_binary(script, x, y, range_remainder, range_remainder_into, "%s %% %s", &range))
+                        status = panic("failed to remainder range object");
+                    break;
+                case op_plus_unary:
+                    x = vector_pop(&stack);
+                    if(script_range_unary(script, x, range_plus_unary, range_plus_unary_into, "+ %s", &range))
+                        status = panic("failed to plus unary range object");
+                    break;
+                case op_minus_unary:
+                    x = vector_pop(&stack);
+                    if(script_range_unary(script, x, range_minus_unary, range_minus_unary_into, "- %s", &range))
+                        status = panic("failed to minus unary range object");
+                    break;
+                case op_bit_not:
+                    x = vector_pop(&stack);
+                    if(script_range_unary(script, x, range_bit_not, range_bit_not_into, "~ %s", &range))
+                        status = panic("failed to bit not range object");
+                    break;
+                case op_increment:
+                    x = vector_pop(&stack);
+                    if(script_range_unary(script, x, range_increment, range_increment_into, "%s ++", &range))
+                        status = panic("failed to increment range object");
+                    break;
+                case op_decrement:
+                    x = vector_pop(&stack);
+                    if(script_range_unary(script, x, range_decrement, range_decrement_into, "%s --", &range))
+                        status = panic("failed to decrement range object");
+                    break;
+                case op_or:
+                    y = vector_pop(&stack);
+                    x = vector_pop(&stack);
+                    if(script_range_logic(script, x, y, "%s || %s", &range))
+                        status = panic("failed to logic range script object");
+                    break;
+                case op_and:
+                    y = vector_pop(&stack);
+                    x = vector_pop(&stack);
+                    if(script_range_logic(script, x, y, "%s && %s", &range))
+                        status = panic("failed to logic range script object");
+                    break;
+                case op_not:
+                    x = vector_pop(&stack);
+                    range = script_range_create(script, integer, "! %s", x->string);
                     if(!range) {
                         status = panic("failed to range script object");
                     } else if(range_add(range->range, 0, 1)) {
                         status = panic("failed to add range object");
+                    }
+                    break;
+                case op_equal:
+                    y = vector_pop(&stack);
+                    x = vector_pop(&stack);
+                    if(script_range_compare(script, x, y, op->flag, range_equal, range_equal, "%s == %s", &range))
+                        status = panic("failed to compare range script object");
+                    break;
+                case op_not_equal:
+                    y = vector_pop(&stack);
+                    x = vector_pop(&stack);
+                    if(script_range_compare(script, x, y, op->flag, range_not_equal, range_not_equal, "%s != %s", &range))
+                        status = panic("failed to compare range script object");
+                    break;
+                case op_lesser:
+                    y = vector_pop(&stack);
+                    x = vector_pop(&stack);
+                    if(script_range_compare(script, x, y, op->flag, range_lesser, range_greater, "%s < %s", &range))
+                        status = panic("failed to compare range script object");
+                    break;
+                case op_lesser_equal:
+                    y = vector_pop(&stack);
+                    x = vector_pop(&stack);
+                    if(script_range_compare(script, x, y, op->flag, range_lesser_equal, range_greater_equal, "%s <= %s", &range))
+                        status = panic("failed to compare range script object");
+                    break;
+                case op_greater:
+                    y = vector_pop(&stack);
+                    x = vector_pop(&stack);
+                    if(script_range_compare(script, x, y, op->flag, range_greater, range_lesser, "%s > %s", &range))
+                        status = panic("failed to compare range script object");
+                    break;
+                case op_greater_equal:
+                    y = vector_pop(&stack);
+                    x = vector_pop(&stack);
+                    if(script_range_compare(script, x, y, op->flag, range_greater_equal, range_lesser_equal, "%s >= %s", &range))
+                        status = panic("failed to compare range script object");
+                    break;
+                case op_if_end:
+                    x = vector_pop(&stack);
+                    next = frame->next;
+                    if(script_run_if(script, frame, x->string))
+                        status = panic("failed to run if script object");
+                    frame = next;
+                    break;
+                case op_else_end:
+                    next = frame->next;
+                    if(script_run_if(script, frame, NULL))
+                        status = panic("failed to run if script object");
+                    frame = next;
+                    break;
+                case op_statement:
+                    x = vector_pop(&stack);
+                    if(op->flag && x->type == identifier) {
+                        if(strbuf_printf(script->strbuf, "%s\n", x->string))
+                            status = panic("failed to printf strbuf object");
+                    }
+                    break;
+                default:
+                    status = panic("invalid opcode - %d", op->opcode);
+                    break;
+            }
+
+            if(!status && range && vector_push(&stack, range))
+                status = panic("failed to push vector object");
+        }
+
+        while(frame)
+            frame = script_frame_pop(script, frame);
+
+        if(!status && result)
+            *result = vector_pop(&stack);
+
+        vector_destroy(&stack);
+    }
+
+    return status;
+}
+
+struct script_frame * script_frame_push(struct script * script, struct script_frame * next, int opcode) {
+    int status = 0;
+
+    struct script_frame * frame;
+
+    frame = store_malloc(&script->store, sizeof(*frame));
+    if(!frame) {
+        status = panic("failed to malloc store object");
+    } else {
+        frame->opcode = opcode;
+        frame->strbuf = NULL;
+        frame->next = next;
+
+        switch(opcode) {
+            case op_vector_push:
+                if(script_vector_push(script, &frame->vector))
+                    status = panic("failed to vector push script object");
+                break;
+            case op_logic_push:
+                if(script_logic_push(script, &frame->logic))
+                    status = panic("failed to logic push script object");
+                break;
+            case op_if_begin:
+                frame->strbuf = script_buffer_get(&script->buffer);
+                if(!frame->strbuf) {
+                    status = panic("failed to get script buffer object");
+                } else {
+                    if(script_strbuf_push(script, frame->strbuf)) {
+                        status = panic("failed to strbuf push script object");
                     } else {
-                        *result = range;
+                        if(script_map_logic_push(script, &frame->map))
+                            status = panic("failed to map logic push script object");
+                        if(status)
+                            script_strbuf_pop(script);
                     }
+                    if(status)
+                        script_buffer_put(&script->buffer, frame->strbuf);
                 }
-            }
+                break;
+            default:
+                status = panic("invalid opcode - %d", opcode);
+                break;
+        }
+    }
+
+    return status ? NULL : frame;
+}
+
+struct script_frame * script_frame_pop(struct script * script, struct script_frame * frame) {
+    switch(frame->opcode) {
+        case op_vector_push:
+            script_vector_pop(script);
             break;
-        default:
-            status = panic("invalid token - %d", root->token);
+        case op_logic_push:
+            script_logic_pop(script);
+            break;
+        case op_if_begin:
+            script_map_logic_pop(script);
+            script_strbuf_pop(script);
+            script_buffer_put(&script->buffer, frame->strbuf);
             break;
     }
 
+    return frame->next;
+}
+
+/*
+ * the block of an if statement is written to its own strbuf
+ * and is only printed after its condition when not empty
+ */
+int script_run_if(struct script * script, struct script_frame * frame, char * cond) {
+    int status = 0;
+
+    char * string;
+
+    strbuf_trim(frame->strbuf);
+    script_map_logic_pop(script);
+    script_strbuf_pop(script);
+
+    string = strbuf_array(frame->strbuf);
+    if(!string) {
+        status = panic("failed to array strbuf object");
+    } else if(*string) {
+        if(cond ? strbuf_printf(script->strbuf, "[%s]\n", cond) : strbuf_printf(script->strbuf, "[else]\n")) {
+            status = panic("failed to printf strbuf object");
+        } else if(strbuf_printf(script->strbuf, "%s\n", string)) {
+            status = panic("failed to printf strbuf object");
+        }
+    }
+
+    script_buffer_put(&script->buffer, frame->strbuf);
+
+    return status;
+}
+
+/*
+ * a comparison within a condition also narrows the
+ * range of each identifier operand by the other one
+ */
+int script_range_compare(struct script * script, struct script_range * x, struct script_range * y, int flag, range_cb left, range_cb right, char * format, struct script_range ** result) {
+    int status = 0;
+
+    struct script_range * range;
+
+    if(flag & is_logic) {
+        if(x->type == identifier) {
+            range = script_range_create(script, identifier, "%s", x->string);
+            if(!range) {
+                status = panic("failed to range script object");
+            } else if(left(range->range, x->range, y->range)) {
+                status = panic("failed to compare range object");
+            } else if(logic_push(script->logic, cond, range)) {
+                status = panic("failed to logic top push script object");
+            }
+        }
+
+        if(y->type == identifier && !status) {
+            range = script_range_create(script, identifier, "%s", y->string);
+            if(!range) {
+                status = panic("failed to range script object");
+            } else if(right(range->range, y->range, x->range)) {
+                status = panic("failed to compare range object");
+            } else if(logic_push(script->logic, cond, range)) {
+                status = panic("failed to logic top push script object");
+            }
+        }
+    }
+
+    if(!status && script_range_logic(script, x, y, format, result))
+        status = panic("failed to logic range script object");
+
     return status;
 }
 
-struct script_range * script_execute(struct script * script, struct stack * stack, struct argument_node * argument) {
+struct script_range * script_execute(struct script * script, struct vector * vector, struct argument_node * argument) {
     int status = 0;
     argument_cb handler;
     struct strbuf * strbuf;
@@ -1809,7 +2325,7 @@ struct script_range * script_execute(struct script * script, struct stack * stac
     struct script_range * range;
     struct range_node * node;
 
-    handler = argument->handler ? map_search(&script->argument, argument->handler) : (void *) argument_print;
+    handler = argument->callback;
     if(!handler) {
         status = panic("invalid argument - %s", argument->handler);
     } else {
@@ -1817,9 +2333,9 @@ struct script_range * script_execute(struct script * script, struct stack * stac
         if(!strbuf) {
             status = panic("failed to get script buffer object");
         } else {
-            if(script_optional(script, stack, argument)) {
+            if(script_optional(script, vector, argument)) {
                 status = panic("failed to optional script object");
-            } else if(handler(script, stack, argument, strbuf)) {
+            } else if(handler(script, vector, argument, strbuf)) {
                 status = panic("failed to execute argument object");
             } else {
                 string = strbuf_string(strbuf);
@@ -1848,38 +2364,43 @@ struct script_range * script_execute(struct script * script, struct stack * stac
     return status ? NULL : range;
 }
 
-int script_optional(struct script * script, struct stack * stack, struct argument_node * argument) {
+int script_optional(struct script * script, struct vector * vector, struct argument_node * argument) {
+    int status = 0;
+
+    struct script_code * code;
     struct optional_node * optional;
     struct script_range * range;
 
     optional = argument->optional;
-    while(optional) {
-        if(!stack_get(stack, optional->index)) {
-            if(script_parse(script, optional->string)) {
-                return panic("failed to parse script object");
-            } else if(script_evaluate(script, script->root->root, 0, &range)) {
-                return panic("failed to evaluate script object");
-            } else if(stack_push(stack, range)) {
-                return panic("failed to push stack object");
+    while(optional && !status) {
+        if(!vector_get(vector, optional->index)) {
+            if(script_code(script, optional->string, 0, &code)) {
+                status = panic("failed to code script object");
+            } else if(script_run(script, code, &range)) {
+                status = panic("failed to run script object");
+            } else {
+                range->temporary = 0;
+                if(vector_push(vector, range))
+                    status = panic("failed to push vector object");
             }
         }
         optional = optional->next;
     }
 
-    return 0;
+    return status;
 }
 
-struct script_range * function_set(struct script * script, struct stack * stack) {
+struct script_range * function_set(struct script * script, struct vector * vector) {
     int status = 0;
     struct script_range * x;
     struct script_range * y;
     struct script_range * range;
 
-    x = stack_get(stack, 0);
+    x = vector_get(vector, 0);
     if(!x) {
         status = panic("invalid indentifier");
     } else {
-        y = stack_get(stack, 1);
+        y = vector_get(vector, 1);
         if(!y) {
             status = panic("invalid expression");
         } else {
@@ -1897,17 +2418,17 @@ struct script_range * function_set(struct script * script, struct stack * stack)
     return status ? NULL : range;
 }
 
-struct script_range * function_min(struct script * script, struct stack * stack) {
+struct script_range * function_min(struct script * script, struct vector * vector) {
     int status = 0;
     struct script_range * x;
     struct script_range * y;
     struct script_range * range;
 
-    x = stack_get(stack, 0);
+    x = vector_get(vector, 0);
     if(!x) {
         status = panic("invalid min");
     } else {
-        y = stack_get(stack, 1);
+        y = vector_get(vector, 1);
         if(!y) {
             status = panic("invalid max");
         } else {
@@ -1923,17 +2444,17 @@ struct script_range * function_min(struct script * script, struct stack * stack)
     return status ? NULL : range;
 }
 
-struct script_range * function_max(struct script * script, struct stack * stack) {
+struct script_range * function_max(struct script * script, struct vector * vector) {
     int status = 0;
     struct script_range * x;
     struct script_range * y;
     struct script_range * range;
 
-    x = stack_get(stack, 0);
+    x = vector_get(vector, 0);
     if(!x) {
         status = panic("invalid min");
     } else {
-        y = stack_get(stack, 1);
+        y = vector_get(vector, 1);
         if(!y) {
             status = panic("invalid max");
         } else {
@@ -1949,17 +2470,17 @@ struct script_range * function_max(struct script * script, struct stack * stack)
     return status ? NULL : range;
 }
 
-struct script_range * function_pow(struct script * script, struct stack * stack) {
+struct script_range * function_pow(struct script * script, struct vector * vector) {
     int status = 0;
     struct script_range * x;
     struct script_range * y;
     struct script_range * range;
 
-    x = stack_get(stack, 0);
+    x = vector_get(vector, 0);
     if(!x) {
         status = panic("invalid base");
     } else {
-        y = stack_get(stack, 1);
+        y = vector_get(vector, 1);
         if(!y) {
             status = panic("invalid power");
         } else {
@@ -1975,17 +2496,17 @@ struct script_range * function_pow(struct script * script, struct stack * stack)
     return status ? NULL : range;
 }
 
-struct script_range * function_rand(struct script * script, struct stack * stack) {
+struct script_range * function_rand(struct script * script, struct vector * vector) {
     int status = 0;
     struct script_range * x;
     struct script_range * y;
     struct script_range * range;
 
-    x = stack_get(stack, 0);
+    x = vector_get(vector, 0);
     if(!x) {
         status = panic("invalid min");
     } else {
-        y = stack_get(stack, 1);
+        y = vector_get(vector, 1);
         if(!y) {
             range = script_range_create(script, integer, "rand(%s)", x->string);
             if(!range) {
@@ -2006,12 +2527,12 @@ struct script_range * function_rand(struct script * script, struct stack * stack
     return status ? NULL : range;
 }
 
-struct script_range * function_bonus(struct script * script, struct stack * stack) {
+struct script_range * function_bonus(struct script * script, struct vector * vector) {
     int status = 0;
     struct script_range * range;
     struct argument_node * argument;
 
-    range = stack_get(stack, 0);
+    range = vector_get(vector, 0);
     if(!range) {
         status = panic("invalid bonus");
     } else {
@@ -2020,7 +2541,7 @@ struct script_range * function_bonus(struct script * script, struct stack * stac
             if(undefined_add(&script->undefined, "bonus.%s", range->string))
                 status = panic("failed to add undefined object");
         } else {
-            range = script_execute(script, stack, argument);
+            range = script_execute(script, vector, argument);
             if(!range)
                 status = panic("failed to execute script object");
         }
@@ -2029,12 +2550,12 @@ struct script_range * function_bonus(struct script * script, struct stack * stac
     return status ? NULL : range;
 }
 
-struct script_range * function_bonus2(struct script * script, struct stack * stack) {
+struct script_range * function_bonus2(struct script * script, struct vector * vector) {
     int status = 0;
     struct script_range * range;
     struct argument_node * argument;
 
-    range = stack_get(stack, 0);
+    range = vector_get(vector, 0);
     if(!range) {
         status = panic("invalid bonus");
     } else {
@@ -2043,7 +2564,7 @@ struct script_range * function_bonus2(struct script * script, struct stack * sta
             if(undefined_add(&script->undefined, "bonus2.%s", range->string))
                 status = panic("failed to add undefined object");
         } else {
-            range = script_execute(script, stack, argument);
+            range = script_execute(script, vector, argument);
             if(!range)
                 status = panic("failed to execute script object");
         }
@@ -2052,12 +2573,12 @@ struct script_range * function_bonus2(struct script * script, struct stack * sta
     return status ? NULL : range;
 }
 
-struct script_range * function_bonus3(struct script * script, struct stack * stack) {
+struct script_range * function_bonus3(struct script * script, struct vector * vector) {
     int status = 0;
     struct script_range * range;
     struct argument_node * argument;
 
-    range = stack_get(stack, 0);
+    range = vector_get(vector, 0);
     if(!range) {
         status = panic("invalid bonus");
     } else {
@@ -2066,7 +2587,7 @@ struct script_range * function_bonus3(struct script * script, struct stack * sta
             if(undefined_add(&script->undefined, "bonus3.%s", range->string))
                 status = panic("failed to add undefined object");
         } else {
-            range = script_execute(script, stack, argument);
+            range = script_execute(script, vector, argument);
             if(!range)
                 status = panic("failed to execute script object");
         }
@@ -2075,12 +2596,12 @@ struct script_range * function_bonus3(struct script * script, struct stack * sta
     return status ? NULL : range;
 }
 
-struct script_range * function_bonus4(struct script * script, struct stack * stack) {
+struct script_range * function_bonus4(struct script * script, struct vector * vector) {
     int status = 0;
     struct script_range * range;
     struct argument_node * argument;
 
-    range = stack_get(stack, 0);
+    range = vector_get(vector, 0);
     if(!range) {
         status = panic("invalid bonus");
     } else {
@@ -2089,7 +2610,7 @@ struct script_range * function_bonus4(struct script * script, struct stack * sta
             if(undefined_add(&script->undefined, "bonus4.%s", range->string))
                 status = panic("failed to add undefined object");
         } else {
-            range = script_execute(script, stack, argument);
+            range = script_execute(script, vector, argument);
             if(!range)
                 status = panic("failed to execute script object");
         }
@@ -2098,12 +2619,12 @@ struct script_range * function_bonus4(struct script * script, struct stack * sta
     return status ? NULL : range;
 }
 
-struct script_range * function_bonus5(struct script * script, struct stack * stack) {
+struct script_range * function_bonus5(struct script * script, struct vector * vector) {
     int status = 0;
     struct script_range * range;
     struct argument_node * argument;
 
-    range = stack_get(stack, 0);
+    range = vector_get(vector, 0);
     if(!range) {
         status = panic("invalid bonus");
     } else {
@@ -2112,7 +2633,7 @@ struct script_range * function_bonus5(struct script * script, struct stack * sta
             if(undefined_add(&script->undefined, "bonus5.%s", range->string))
                 status = panic("failed to add undefined object");
         } else {
-            range = script_execute(script, stack, argument);
+            range = script_execute(script, vector, argument);
             if(!range)
                 status = panic("failed to execute script object");
         }
@@ -2121,7 +2642,7 @@ struct script_range * function_bonus5(struct script * script, struct stack * sta
     return status ? NULL : range;
 }
 
-struct script_range * function_getskilllv(struct script * script, struct stack * stack) {
+struct script_range * function_getskilllv(struct script * script, struct vector * vector) {
     int status = 0;
     struct script_range * index;
     struct script_range * range;
@@ -2133,13 +2654,13 @@ struct script_range * function_getskilllv(struct script * script, struct stack *
         if(undefined_add(&script->undefined, "statement.getskilllv"))
             status = panic("failed to add undefined object");
     } else {
-        range = script_execute(script, stack, argument);
+        range = script_execute(script, vector, argument);
         if(!range) {
             status = panic("failed to execute script object");
         } else {
-            index = stack_get(stack, 0);
+            index = vector_get(vector, 0);
             if(!index) {
-                status = panic("failed to get stack object");
+                status = panic("failed to get vector object");
             } else {
                 skill = skill_id(script->table, index->range->min);
                 if(skill) {
@@ -2161,15 +2682,15 @@ struct script_range * function_getskilllv(struct script * script, struct stack *
     return status ? NULL : range;
 }
 
-struct script_range * function_constant(struct script * script, struct stack * stack) {
+struct script_range * function_constant(struct script * script, struct vector * vector) {
     int status = 0;
     struct script_range * range;
     struct constant_node * constant;
     struct range_node * node;
 
-    range = stack_get(stack, 0);
+    range = vector_get(vector, 0);
     if(!range) {
-        status = panic("failed to get stack object");
+        status = panic("failed to get vector object");
     } else {
         constant = constant_identifier(script->table, range->string);
         if(!constant) {
@@ -2200,24 +2721,21 @@ struct script_range * function_constant(struct script * script, struct stack * s
     return status ? NULL : range;
 }
 
-int entry_node_load(struct entry_node * entry, struct stack * result, struct stack * source) {
+int entry_node_load(struct entry_node * entry, struct vector * result, struct vector * source) {
     size_t i;
     struct script_range * range;
 
     if(!entry->count) {
-        range = stack_start(source);
-        while(range) {
-            if(stack_push(result, range))
-                return panic("failed to push stack object");
-            range = stack_next(source);
-        }
+        for(i = 0; i < source->count; i++)
+            if(vector_push(result, source->array[i]))
+                return panic("failed to push vector object");
     } else {
         for(i = 0; i < entry->count; i++) {
-            range = stack_get(source, entry->array[i]);
+            range = vector_get(source, entry->array[i]);
             if(!range) {
-                return panic("failed to get stack object");
-            } else if(stack_push(result, range)) {
-                return panic("failed to push stack object");
+                return panic("failed to get vector object");
+            } else if(vector_push(result, range)) {
+                return panic("failed to push vector object");
             }
         }
     }
@@ -2225,19 +2743,19 @@ int entry_node_load(struct entry_node * entry, struct stack * result, struct sta
     return 0;
 }
 
-int entry_node_call(struct entry_node * entry, struct script * script, struct stack * stack, struct strbuf * strbuf) {
+int entry_node_call(struct entry_node * entry, struct script * script, struct vector * vector, struct strbuf * strbuf) {
     argument_cb handler;
     struct argument_node * argument;
     struct script_range * range;
 
-    handler = map_search(&script->argument, entry->identifier);
+    handler = entry->callback;
     if(handler) {
-        if(handler(script, stack, NULL, strbuf))
+        if(handler(script, vector, NULL, strbuf))
             return panic("failed to execute argument object");
     } else {
-        argument = argument_identifier(script->table, entry->identifier);
+        argument = entry->argument;
         if(argument) {
-            range = script_execute(script, stack, argument);
+            range = script_execute(script, vector, argument);
             if(!range) {
                 return panic("failed to execute script object");
             } else if(strbuf_printf(strbuf, "%s", range->string)) {
@@ -2251,36 +2769,36 @@ int entry_node_call(struct entry_node * entry, struct script * script, struct st
     return 0;
 }
 
-int print_node_write(struct print_node * print, struct script * script, struct stack * stack, struct strbuf * strbuf) {
+int print_node_write(struct print_node * print, struct script * script, struct vector * vector, struct strbuf * strbuf) {
     int status = 0;
-    struct stack subset;
+    struct vector subset;
     struct entry_node * entry;
 
-    if(stack_create(&subset, script->heap->stack_pool)) {
-        status = panic("failed to create stack object");
+    if(vector_create(&subset)) {
+        status = panic("failed to create vector object");
     } else {
         entry = print->entry;
         while(entry && !status) {
             if(strbuf_strcpy(strbuf, entry->string, entry->length)) {
                 status = panic("failed to strcpy strbuf object");
             } else if(entry->identifier) {
-                if(entry_node_load(entry, &subset, stack)) {
+                if(entry_node_load(entry, &subset, vector)) {
                     status = panic("failed to load entry node object");
                 } else if(entry_node_call(entry, script, &subset, strbuf)) {
                     status = panic("failed to call entry node object");
                 } else {
-                    stack_clear(&subset);
+                    vector_clear(&subset);
                 }
             }
             entry = entry->next;
         }
-        stack_destroy(&subset);
+        vector_destroy(&subset);
     }
 
     return status;
 }
 
-int argument_print(struct script * script, struct stack * stack, struct argument_node * argument, struct strbuf * strbuf) {
+int argument_print(struct script * script, struct vector * vector, struct argument_node * argument, struct strbuf * strbuf) {
     char * anchor;
     struct print_node * print;
 
@@ -2292,7 +2810,7 @@ int argument_print(struct script * script, struct stack * stack, struct argument
                 return panic("failed to putc strbuf object");
         anchor = strbuf->pos;
 
-        if(print_node_write(print, script, stack, strbuf))
+        if(print_node_write(print, script, vector, strbuf))
             return panic("failed to parse argument object");
         print = print->next;
     }
@@ -2302,48 +2820,54 @@ int argument_print(struct script * script, struct stack * stack, struct argument
     return 0;
 }
 
-int argument_prefix(struct script * script, struct stack * stack, struct argument_node * argument, struct strbuf * strbuf) {
+int argument_prefix(struct script * script, struct vector * vector, struct argument_node * argument, struct strbuf * strbuf) {
     struct print_node * print;
     struct script_range * range;
 
-    range = stack_get(stack, 0);
+    range = vector_get(vector, 0);
     if(!range) {
-        return panic("failed to get stack object");
+        return panic("failed to get vector object");
     } else {
         print = argument->print;
         if(range->range->max < 0)
             print = print->next;
 
-        if(print_node_write(print, script, stack, strbuf))
+        if(print_node_write(print, script, vector, strbuf))
             return panic("failed to write argument object");
     }
 
     return 0;
 }
 
-int argument_zero(struct script * script, struct stack * stack, struct argument_node * argument, struct strbuf * strbuf) {
+int argument_zero(struct script * script, struct vector * vector, struct argument_node * argument, struct strbuf * strbuf) {
     struct script_range * range;
 
-    range = stack_get(stack, 0);
+    range = vector_get(vector, 0);
     if(!range) {
-        return panic("failed to get stack object");
+        return panic("failed to get vector object");
     } else if(range->range->min || range->range->max) {
-        if(print_node_write(argument->print, script, stack, strbuf))
+        if(print_node_write(argument->print, script, vector, strbuf))
             return panic("failed to write argument object");
     }
 
     return 0;
 }
 
-int argument_array(struct script * script, struct stack * stack, struct argument_node * argument, struct strbuf * strbuf) {
+int argument_array(struct script * script, struct vector * vector, struct argument_node * argument, struct strbuf * strbuf) {
     long i;
     struct script_range * range;
     struct range_node * node;
     char * string = NULL;
 
-    range = stack_start(stack);
+    range = vector_start(vector);
     while(range) {
-        node = range->range->root;
+        if(range->range->approximate) {
+            if(strbuf_printf(strbuf, "%s, ", range->string))
+                return panic("failed to printf strbuf object");
+            string = range->string;
+        }
+
+        node = range->range->approximate ? NULL : range->range->root;
         while(node) {
             for(i = node->min; i <= node->max; i++) {
                 string = map_search(argument->map, &i);
@@ -2355,7 +2879,7 @@ int argument_array(struct script * script, struct stack * stack, struct argument
             }
             node = node->next;
         }
-        range = stack_next(stack);
+        range = vector_next(vector);
     }
 
     if(string && strbuf_unputn(strbuf, 2))
@@ -2364,7 +2888,7 @@ int argument_array(struct script * script, struct stack * stack, struct argument
     return 0;
 }
 
-int argument_integer(struct script * script, struct stack * stack, struct argument_node * argument, struct strbuf * strbuf) {
+int argument_integer(struct script * script, struct vector * vector, struct argument_node * argument, struct strbuf * strbuf) {
     long min;
     long max;
     long tmp;
@@ -2374,9 +2898,9 @@ int argument_integer(struct script * script, struct stack * stack, struct argume
 
     struct script_range * range;
 
-    range = stack_get(stack, 0);
+    range = vector_get(vector, 0);
     if(!range) {
-        return panic("failed to get stack object");
+        return panic("failed to get vector object");
     } else {
         if(argument->integer) {
             flag = argument->integer->flag;
@@ -2469,12 +2993,12 @@ int argument_integer(struct script * script, struct stack * stack, struct argume
     return 0;
 }
 
-int argument_string(struct script * script, struct stack * stack, struct argument_node * argument, struct strbuf * strbuf) {
+int argument_string(struct script * script, struct vector * vector, struct argument_node * argument, struct strbuf * strbuf) {
     struct script_range * range;
 
-    range = stack_get(stack, 0);
+    range = vector_get(vector, 0);
     if(!range) {
-        return panic("failed to get stack object");
+        return panic("failed to get vector object");
     } else if(strbuf_printf(strbuf, "%s", range->string)) {
         return panic("failed to printf strbuf object");
     }
@@ -2482,15 +3006,15 @@ int argument_string(struct script * script, struct stack * stack, struct argumen
     return 0;
 }
 
-int argument_second(struct script * script, struct stack * stack, struct argument_node * argument, struct strbuf * strbuf) {
+int argument_second(struct script * script, struct vector * vector, struct argument_node * argument, struct strbuf * strbuf) {
     struct script_range * range;
 
     long min;
     struct print_node * print;
 
-    range = stack_get(stack, 0);
+    range = vector_get(vector, 0);
     if(!range) {
-        return panic("failed to get stack object");
+        return panic("failed to get vector object");
     } else {
         min = range->range->min;
 
@@ -2512,11 +3036,11 @@ int argument_second(struct script * script, struct stack * stack, struct argumen
             }
         }
 
-        if(argument_integer(script, stack, argument, strbuf)) {
+        if(argument_integer(script, vector, argument, strbuf)) {
             return panic("failed to integer argument");
         } else if(strbuf_printf(strbuf, " ")) {
             return panic("failed to printf strbuf object");
-        } else if(print_node_write(print, script, stack, strbuf)) {
+        } else if(print_node_write(print, script, vector, strbuf)) {
             return panic("failed to write argument object");
         }
     }
@@ -2524,15 +3048,15 @@ int argument_second(struct script * script, struct stack * stack, struct argumen
     return 0;
 }
 
-int argument_millisecond(struct script * script, struct stack * stack, struct argument_node * argument, struct strbuf * strbuf) {
+int argument_millisecond(struct script * script, struct vector * vector, struct argument_node * argument, struct strbuf * strbuf) {
     struct script_range * range;
 
     long min;
     struct print_node * print;
 
-    range = stack_get(stack, 0);
+    range = vector_get(vector, 0);
     if(!range) {
-        return panic("failed to get stack object");
+        return panic("failed to get vector object");
     } else {
         min = range->range->min;
 
@@ -2559,11 +3083,11 @@ int argument_millisecond(struct script * script, struct stack * stack, struct ar
             }
         }
 
-        if(argument_integer(script, stack, argument, strbuf)) {
+        if(argument_integer(script, vector, argument, strbuf)) {
             return panic("failed to integer argument");
         } else if(strbuf_printf(strbuf, " ")) {
             return panic("failed to printf strbuf object");
-        } else if(print_node_write(print, script, stack, strbuf)) {
+        } else if(print_node_write(print, script, vector, strbuf)) {
             return panic("failed to write argument object");
         }
     }
@@ -2571,13 +3095,13 @@ int argument_millisecond(struct script * script, struct stack * stack, struct ar
     return 0;
 }
 
-int argument_constant(struct script * script, struct stack * stack, struct argument_node * argument, struct strbuf * strbuf) {
+int argument_constant(struct script * script, struct vector * vector, struct argument_node * argument, struct strbuf * strbuf) {
     struct script_range * range;
     struct constant_node * constant;
 
-    range = stack_get(stack, 0);
+    range = vector_get(vector, 0);
     if(!range) {
-        return panic("failed to get stack object");
+        return panic("failed to get vector object");
     } else {
         constant = constant_identifier(script->table, range->string);
         if(!constant) {
@@ -2592,18 +3116,23 @@ int argument_constant(struct script * script, struct stack * stack, struct argum
     return 0;
 }
 
-int argument_item(struct script * script, struct stack * stack, struct argument_node * argument, struct strbuf * strbuf) {
+int argument_item(struct script * script, struct vector * vector, struct argument_node * argument, struct strbuf * strbuf) {
     long i;
     struct script_range * range;
     struct range_node * node;
     struct item_node * item = NULL;
+    int approximate = 0;
 
-    range = stack_start(stack);
+    range = vector_start(vector);
     while(range) {
         item = item_name(script->table, range->string);
         if(item) {
             if(strbuf_printf(strbuf, "%s, ", item->name))
                 return panic("failed to printf strbuf object");
+        } else if(range->range->approximate) {
+            if(strbuf_printf(strbuf, "%s, ", range->string))
+                return panic("failed to printf strbuf object");
+            approximate = 1;
         } else {
             node = range->range->root;
             while(node) {
@@ -2618,27 +3147,32 @@ int argument_item(struct script * script, struct stack * stack, struct argument_
                 node = node->next;
             }
         }
-        range = stack_next(stack);
+        range = vector_next(vector);
     }
 
-    if(item && strbuf_unputn(strbuf, 2))
+    if((item || approximate) && strbuf_unputn(strbuf, 2))
         return panic("failed to unputn strbuf object");
 
     return 0;
 }
 
-int argument_skill(struct script * script, struct stack * stack, struct argument_node * argument, struct strbuf * strbuf) {
+int argument_skill(struct script * script, struct vector * vector, struct argument_node * argument, struct strbuf * strbuf) {
     size_t i;
     struct script_range * range;
     struct range_node * node;
     struct skill_node * skill = NULL;
+    int approximate = 0;
 
-    range = stack_start(stack);
+    range = vector_start(vector);
     while(range) {
         skill = skill_name(script->table, range->string);
         if(skill) {
             if(strbuf_printf(strbuf, "%s, ", skill->description))
                 return panic("failed to printf strbuf object");
+        } else if(range->range->approximate) {
+            if(strbuf_printf(strbuf, "%s, ", range->string))
+                return panic("failed to printf strbuf object");
+            approximate = 1;
         } else {
             node = range->range->root;
             while(node) {
@@ -2653,27 +3187,32 @@ int argument_skill(struct script * script, struct stack * stack, struct argument
                 node = node->next;
             }
         }
-        range = stack_next(stack);
+        range = vector_next(vector);
     }
 
-    if(skill && strbuf_unputn(strbuf, 2))
+    if((skill || approximate) && strbuf_unputn(strbuf, 2))
         return panic("failed to unputn strbuf object");
 
     return 0;
 }
 
-int argument_mob(struct script * script, struct stack * stack, struct argument_node * argument, struct strbuf * strbuf) {
+int argument_mob(struct script * script, struct vector * vector, struct argument_node * argument, struct strbuf * strbuf) {
     long i;
     struct script_range * range;
     struct range_node * node;
     struct mob_node * mob = NULL;
+    int approximate = 0;
 
-    range = stack_start(stack);
+    range = vector_start(vector);
     while(range) {
         mob = mob_sprite(script->table, range->string);
         if(mob) {
             if(strbuf_printf(strbuf, "%s, ", mob->kro))
                 return panic("failed to printf strbuf object");
+        } else if(range->range->approximate) {
+            if(strbuf_printf(strbuf, "%s, ", range->string))
+                return panic("failed to printf strbuf object");
+            approximate = 1;
         } else {
             node = range->range->root;
             while(node) {
@@ -2688,24 +3227,31 @@ int argument_mob(struct script * script, struct stack * stack, struct argument_n
                 node = node->next;
             }
         }
-        range = stack_next(stack);
+        range = vector_next(vector);
     }
 
-    if(mob && strbuf_unputn(strbuf, 2))
+    if((mob || approximate) && strbuf_unputn(strbuf, 2))
         return panic("failed to unputn strbuf object");
 
     return 0;
 }
 
-int argument_mercenary(struct script * script, struct stack * stack, struct argument_node * argument, struct strbuf * strbuf) {
+int argument_mercenary(struct script * script, struct vector * vector, struct argument_node * argument, struct strbuf * strbuf) {
     long i;
     struct script_range * range;
     struct range_node * node;
     struct mercenary_node * mercenary = NULL;
+    int approximate = 0;
 
-    range = stack_start(stack);
+    range = vector_start(vector);
     while(range) {
-        node = range->range->root;
+        if(range->range->approximate) {
+            if(strbuf_printf(strbuf, "%s, ", range->string))
+                return panic("failed to printf strbuf object");
+            approximate = 1;
+        }
+
+        node = range->range->approximate ? NULL : range->range->root;
         while(node) {
             for(i = node->min; i <= node->max; i++) {
                 mercenary = mercenary_id(script->table, i);
@@ -2717,16 +3263,16 @@ int argument_mercenary(struct script * script, struct stack * stack, struct argu
             }
             node = node->next;
         }
-        range = stack_next(stack);
+        range = vector_next(vector);
     }
 
-    if(mercenary && strbuf_unputn(strbuf, 2))
+    if((mercenary || approximate) && strbuf_unputn(strbuf, 2))
         return panic("failed to unputn strbuf object");
 
     return 0;
 }
 
-int argument_group(struct script * script, struct stack * stack, struct strbuf * strbuf, char * group) {
+int argument_group(struct script * script, struct vector * vector, struct strbuf * strbuf, enum script_group group) {
     long i;
     struct range_node * node;
 
@@ -2734,18 +3280,22 @@ int argument_group(struct script * script, struct stack * stack, struct strbuf *
     struct constant_node * constant;
     struct constant_group_node * constant_group;
 
-    constant_group = constant_group_identifier(script->table, group);
-    if(!constant_group)
-        return panic("failed to get constant group - %s", group);
+    if(script_table_setup(script))
+        return panic("failed to table setup script object");
+
+    constant_group = script->group[group];
 
-    range = stack_get(stack, 0);
+    range = vector_get(vector, 0);
     if(!range)
-        return panic("failed to get stack object");
+        return panic("failed to get vector object");
 
     constant = map_search(&constant_group->map_identifier, range->string);
     if(constant) {
         if(strbuf_printf(strbuf, "%s", constant->tag))
             return panic("failed to printf strbuf object");
+    } else if(range->range->approximate) {
+        if(strbuf_printf(strbuf, "%s", range->string))
+            return panic("failed to printf strbuf object");
     } else {
         node = range->range->root;
         while(node) {
@@ -2767,47 +3317,47 @@ int argument_group(struct script * script, struct stack * stack, struct strbuf *
     return 0;
 }
 
-int argument_element(struct script * script, struct stack * stack, struct argument_node * argument, struct strbuf * strbuf) {
-    return argument_group(script, stack, strbuf, "element");
+int argument_element(struct script * script, struct vector * vector, struct argument_node * argument, struct strbuf * strbuf) {
+    return argument_group(script, vector, strbuf, group_element);
 }
 
-int argument_equip(struct script * script, struct stack * stack, struct argument_node * argument, struct strbuf * strbuf) {
-    return argument_group(script, stack, strbuf, "equip");
+int argument_equip(struct script * script, struct vector * vector, struct argument_node * argument, struct strbuf * strbuf) {
+    return argument_group(script, vector, strbuf, group_equip);
 }
 
-int argument_job(struct script * script, struct stack * stack, struct argument_node * argument, struct strbuf * strbuf) {
-    return argument_group(script, stack, strbuf, "job");
+int argument_job(struct script * script, struct vector * vector, struct argument_node * argument, struct strbuf * strbuf) {
+    return argument_group(script, vector, strbuf, group_job);
 }
 
-int argument_size(struct script * script, struct stack * stack, struct argument_node * argument, struct strbuf * strbuf) {
-    return argument_group(script, stack, strbuf, "size");
+int argument_size(struct script * script, struct vector * vector, struct argument_node * argument, struct strbuf * strbuf) {
+    return argument_group(script, vector, strbuf, group_size);
 }
 
-int argument_race(struct script * script, struct stack * stack, struct argument_node * argument, struct strbuf * strbuf) {
-    return argument_group(script, stack, strbuf, "race");
+int argument_race(struct script * script, struct vector * vector, struct argument_node * argument, struct strbuf * strbuf) {
+    return argument_group(script, vector, strbuf, group_race);
 }
 
-int argument_mob_race(struct script * script, struct stack * stack, struct argument_node * argument, struct strbuf * strbuf) {
-    return argument_group(script, stack, strbuf, "mob_race");
+int argument_mob_race(struct script * script, struct vector * vector, struct argument_node * argument, struct strbuf * strbuf) {
+    return argument_group(script, vector, strbuf, group_mob_race);
 }
 
-int argument_effect(struct script * script, struct stack * stack, struct argument_node * argument, struct strbuf * strbuf) {
-    return argument_group(script, stack, strbuf, "effect");
+int argument_effect(struct script * script, struct vector * vector, struct argument_node * argument, struct strbuf * strbuf) {
+    return argument_group(script, vector, strbuf, group_effect);
 }
 
-int argument_class(struct script * script, struct stack * stack, struct argument_node * argument, struct strbuf * strbuf) {
-    return argument_group(script, stack, strbuf, "class");
+int argument_class(struct script * script, struct vector * vector, struct argument_node * argument, struct strbuf * strbuf) {
+    return argument_group(script, vector, strbuf, group_class);
 }
 
-int argument_splash(struct script * script, struct stack * stack, struct argument_node * argument, struct strbuf * strbuf) {
+int argument_splash(struct script * script, struct vector * vector, struct argument_node * argument, struct strbuf * strbuf) {
     struct script_range * range;
 
     long min;
     long max;
 
-    range = stack_get(stack, 0);
+    range = vector_get(vector, 0);
     if(!range)
-        return panic("failed to get stack object");
+        return panic("failed to get vector object");
 
     min = range->range->min * 2 + 1;
     max = range->range->max * 2 + 1;
@@ -2821,14 +3371,17 @@ int argument_splash(struct script * script, struct stack * stack, struct argumen
     return 0;
 }
 
-int argument_bf(struct script * script, struct stack * stack, struct argument_node * argument, struct strbuf * strbuf) {
+int argument_bf(struct script * script, struct vector * vector, struct argument_node * argument, struct strbuf * strbuf) {
     long flag;
     struct print_node * print;
     struct script_range * range;
 
-    range = stack_get(stack, 0);
+    if(script_table_setup(script))
+        return panic("failed to table setup script object");
+
+    range = vector_get(vector, 0);
     if(!range)
-        return panic("failed to get stack object");
+        return panic("failed to get vector object");
 
     flag = range->range->min | range->range->max;
 
@@ -2841,7 +3394,7 @@ int argument_bf(struct script * script, struct stack * stack, struct argument_no
     print = argument->print;
 
     if(flag & BF_MAGIC) {
-        if(print_node_write(print, script, stack, strbuf)) {
+        if(print_node_write(print, script, vector, strbuf)) {
             return panic("failed to write print node object");
         } else if(strbuf_printf(strbuf, ", ")) {
             return panic("failed to printf strbuf object");
@@ -2851,7 +3404,7 @@ int argument_bf(struct script * script, struct stack * stack, struct argument_no
     print = print->next;
 
     if(flag & BF_MISC) {
-        if(print_node_write(print, script, stack, strbuf)) {
+        if(print_node_write(print, script, vector, strbuf)) {
             return panic("failed to write print node object");
         } else if(strbuf_printf(strbuf, ", ")) {
             return panic("failed to printf strbuf object");
@@ -2864,19 +3417,19 @@ int argument_bf(struct script * script, struct stack * stack, struct argument_no
         flag = flag & (BF_SHORT | BF_LONG);
 
         if(flag == BF_SHORT)
-            if(print_node_write(print, script, stack, strbuf))
+            if(print_node_write(print, script, vector, strbuf))
                 return panic("failed to write print node object");
 
         print = print->next;
 
         if(flag == BF_LONG)
-            if(print_node_write(print, script, stack, strbuf))
+            if(print_node_write(print, script, vector, strbuf))
                 return panic("failed to write print node object");
 
         print = print->next;
 
         if(flag == (BF_SHORT | BF_LONG))
-            if(print_node_write(print, script, stack, strbuf))
+            if(print_node_write(print, script, vector, strbuf))
                 return panic("failed to write print node object");
 
         if(strbuf_printf(strbuf, ", "))
@@ -2889,14 +3442,17 @@ int argument_bf(struct script * script, struct stack * stack, struct argument_no
     return 0;
 }
 
-int argument_atf_target(struct script * script, struct stack * stack, struct argument_node * argument, struct strbuf * strbuf) {
+int argument_atf_target(struct script * script, struct vector * vector, struct argument_node * argument, struct strbuf * strbuf) {
     long flag;
     struct print_node * print;
     struct script_range * range;
 
-    range = stack_get(stack, 0);
+    if(script_table_setup(script))
+        return panic("failed to table setup script object");
+
+    range = vector_get(vector, 0);
     if(!range)
-        return panic("failed to get stack object");
+        return panic("failed to get vector object");
 
     flag = range->range->min | range->range->max;
 
@@ -2906,7 +3462,7 @@ int argument_atf_target(struct script * script, struct stack * stack, struct arg
     print = argument->print;
 
     if(flag & ATF_SELF) {
-        if(print_node_write(print, script, stack, strbuf)) {
+        if(print_node_write(print, script, vector, strbuf)) {
             return panic("failed to write print node object");
         } else if(strbuf_printf(strbuf, ", ")) {
             return panic("failed to printf strbuf object");
@@ -2916,7 +3472,7 @@ int argument_atf_target(struct script * script, struct stack * stack, struct arg
     print = print->next;
 
     if(flag & ATF_TARGET) {
-        if(print_node_write(print, script, stack, strbuf)) {
+        if(print_node_write(print, script, vector, strbuf)) {
             return panic("failed to write print node object");
         } else if(strbuf_printf(strbuf, ", ")) {
             return panic("failed to printf strbuf object");
@@ -2929,14 +3485,17 @@ int argument_atf_target(struct script * script, struct stack * stack, struct arg
     return 0;
 }
 
-int argument_atf_trigger(struct script * script, struct stack * stack, struct argument_node * argument, struct strbuf * strbuf) {
+int argument_atf_trigger(struct script * script, struct vector * vector, struct argument_node * argument, struct strbuf * strbuf) {
     long flag;
     struct print_node * print;
     struct script_range * range;
 
-    range = stack_get(stack, 0);
+    if(script_table_setup(script))
+        return panic("failed to table setup script object");
+
+    range = vector_get(vector, 0);
     if(!range)
-        return panic("failed to get stack object");
+        return panic("failed to get vector object");
 
     flag = range->range->min | range->range->max;
 
@@ -2952,7 +3511,7 @@ int argument_atf_trigger(struct script * script, struct stack * stack, struct ar
     print = argument->print;
 
     if(flag & ATF_MAGIC) {
-        if(print_node_write(print, script, stack, strbuf)) {
+        if(print_node_write(print, script, vector, strbuf)) {
             return panic("failed to write print node object");
         } else if(strbuf_printf(strbuf, ", ")) {
             return panic("failed to printf strbuf object");
@@ -2962,7 +3521,7 @@ int argument_atf_trigger(struct script * script, struct stack * stack, struct ar
     print = print->next;
 
     if(flag & ATF_MISC) {
-        if(print_node_write(print, script, stack, strbuf)) {
+        if(print_node_write(print, script, vector, strbuf)) {
             return panic("failed to write print node object");
         } else if(strbuf_printf(strbuf, ", ")) {
             return panic("failed to printf strbuf object");
@@ -2975,19 +3534,19 @@ int argument_atf_trigger(struct script * script, struct stack * stack, struct ar
         flag = flag & (ATF_SHORT | ATF_LONG);
 
         if(flag == ATF_SHORT)
-            if(print_node_write(print, script, stack, strbuf))
+            if(print_node_write(print, script, vector, strbuf))
                 return panic("failed to write print node object");
 
         print = print->next;
 
         if(flag == ATF_LONG)
-            if(print_node_write(print, script, stack, strbuf))
+            if(print_node_write(print, script, vector, strbuf))
                 return panic("failed to write print node object");
 
         print = print->next;
 
         if(flag == (ATF_SHORT | ATF_LONG))
-            if(print_node_write(print, script, stack, strbuf))
+            if(print_node_write(print, script, vector, strbuf))
                 return panic("failed to write print node object");
 
         if(strbuf_printf(strbuf, ", "))
@@ -3000,12 +3559,12 @@ int argument_atf_trigger(struct script * script, struct stack * stack, struct ar
     return 0;
 }
 
-int argument_script(struct script * script, struct stack * stack, struct argument_node * argument, struct strbuf * strbuf) {
+int argument_script(struct script * script, struct vector * vector, struct argument_node * argument, struct strbuf * strbuf) {
     struct script_range * range;
 
-    range = stack_get(stack, 0);
+    range = vector_get(vector, 0);
     if(!range)
-        return panic("failed to get stack object");
+        return panic("failed to get vector object");
 
     if(script_generate(script, range->string, strbuf))
         return panic("failed to compile script object");
@@ -3013,10 +3572,10 @@ int argument_script(struct script * script, struct stack * stack, struct argumen
     return 0;
 }
 
-int argument_sc_start(struct script * script, struct stack * stack, struct argument_node * argument, struct strbuf * strbuf) {
+int argument_sc_start(struct script * script, struct vector * vector, struct argument_node * argument, struct strbuf * strbuf) {
     struct script_range * range;
 
-    range = stack_get(stack, 0);
+    range = vector_get(vector, 0);
     if(!range) {
         return panic("invalid bonus");
     } else {
@@ -3025,7 +3584,7 @@ int argument_sc_start(struct script * script, struct stack * stack, struct argum
             if(undefined_add(&script->undefined, "sc_start.%s", range->string))
                 return panic("failed to add undefined object");
         } else {
-            range = script_execute(script, stack, argument);
+            range = script_execute(script, vector, argument);
             if(!range) {
                 return panic("failed to execute script object");
             } else if(strbuf_printf(strbuf, "%s", range->string)) {
@@ -3037,10 +3596,10 @@ int argument_sc_start(struct script * script, struct stack * stack, struct argum
     return 0;
 }
 
-int argument_sc_start2(struct script * script, struct stack * stack, struct argument_node * argument, struct strbuf * strbuf) {
+int argument_sc_start2(struct script * script, struct vector * vector, struct argument_node * argument, struct strbuf * strbuf) {
     struct script_range * range;
 
-    range = stack_get(stack, 0);
+    range = vector_get(vector, 0);
     if(!range) {
         return panic("invalid bonus");
     } else {
@@ -3049,7 +3608,7 @@ int argument_sc_start2(struct script * script, struct stack * stack, struct argu
             if(undefined_add(&script->undefined, "sc_start2.%s", range->string))
                 return panic("failed to add undefined object");
         } else {
-            range = script_execute(script, stack, argument);
+            range = script_execute(script, vector, argument);
             if(!range) {
                 return panic("failed to execute script object");
             } else if(strbuf_printf(strbuf, "%s", range->string)) {
@@ -3061,10 +3620,10 @@ int argument_sc_start2(struct script * script, struct stack * stack, struct argu
     return 0;
 }
 
-int argument_sc_start4(struct script * script, struct stack * stack, struct argument_node * argument, struct strbuf * strbuf) {
+int argument_sc_start4(struct script * script, struct vector * vector, struct argument_node * argument, struct strbuf * strbuf) {
     struct script_range * range;
 
-    range = stack_get(stack, 0);
+    range = vector_get(vector, 0);
     if(!range) {
         return panic("invalid bonus");
     } else {
@@ -3073,7 +3632,7 @@ int argument_sc_start4(struct script * script, struct stack * stack, struct argu
             if(undefined_add(&script->undefined, "sc_start4.%s", range->string))
                 return panic("failed to add undefined object");
         } else {
-            range = script_execute(script, stack, argument);
+            range = script_execute(script, vector, argument);
             if(!range) {
                 return panic("failed to execute script object");
             } else if(strbuf_printf(strbuf, "%s", range->string)) {
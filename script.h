@@ -13,6 +13,52 @@ struct script_node {
     struct script_node * next;
 };
 
+/*
+ * a script is lowered once into a flat array of ops that
+ * script_run evaluates with a stack of script ranges; flag
+ * is the operand of the op and jump is the index of the op
+ * that follows a branch
+ */
+struct script_op {
+    int opcode;
+    int flag;
+    size_t jump;
+    union {
+        long integer;
+        char * identifier;
+        void * function;
+        struct argument_node * argument;
+        struct constant_node * constant;
+    };
+};
+
+#define SCRIPT_CODE_SIZE 64
+
+/*
+ * an identifier resolves to the same function, statement
+ * and constant in every script so each is looked up once,
+ * the first time it is needed; flag marks the looked up
+ */
+enum script_symbol_flag {
+    symbol_function = 0x1,
+    symbol_argument = 0x2,
+    symbol_constant = 0x4
+};
+
+struct script_symbol {
+    char * identifier;
+    int flag;
+    void * function;
+    struct argument_node * argument;
+    struct constant_node * constant;
+};
+
+struct script_code {
+    struct script_op * op;
+    size_t count;
+    size_t total;
+};
+
 enum script_type {
     integer,
     identifier,
@@ -21,6 +67,7 @@ enum script_type {
 
 struct script_range {
     enum script_type type;
+    int temporary;
     struct range * range;
     char * string;
     struct script_range * next;
@@ -48,28 +95,48 @@ void undefined_destroy(struct undefined *);
 int undefined_add(struct undefined *, char *, ...);
 void undefined_print(struct undefined *);
 
+enum script_group {
+    group_element,
+    group_equip,
+    group_job,
+    group_size,
+    group_race,
+    group_mob_race,
+    group_effect,
+    group_class,
+    group_count
+};
+
 struct script {
     struct heap * heap;
     struct table * table;
     void * scanner;
     void * parser;
     struct store store;
+    struct store code_store;
+    struct map code_map;
+    struct map optional_map;
+    struct map symbol_map;
     struct stack map_stack;
     struct stack logic_stack;
-    struct stack stack_stack;
+    struct stack vector_stack;
     struct stack strbuf_stack;
     struct stack map_logic_stack;
     struct map function;
     struct map argument;
+    struct logic_table logic_table;
     struct script_buffer buffer;
     struct undefined undefined;
     struct script_node * root;
     struct map * map;
     struct logic * logic;
-    struct stack * stack;
+    struct vector * vector;
     struct strbuf * strbuf;
     struct map * map_logic;
     struct script_range * range;
+    struct constant_group_node * group[group_count];
+    int approximate;
+    int setup;
 };
 
 int script_setup(struct table *);
@@ -39,6 +39,33 @@ void store_clear(struct store * store) {
     }
 }
 
+/*
+ * move the nodes of from behind the node that store
+ * allocates from, objects keep their address
+ */
+int store_merge(struct store * store, struct store * from) {
+    int status = 0;
+    struct store_node * node;
+
+    if(store->size != from->size) {
+        status = panic("invalid size");
+    } else if(from->root) {
+        node = from->root;
+        while(node->next)
+            node = node->next;
+
+        if(store->root) {
+            node->next = store->root->next;
+            store->root->next = from->root;
+        } else {
+            store->root = from->root;
+        }
+        from->root = NULL;
+    }
+
+    return status;
+}
+
 int store_alloc(struct store * store) {
     int status = 0;
     struct store_node * node;
@@ -18,6 +18,7 @@ struct store {
 int store_create(struct store *, size_t);
 void store_destroy(struct store *);
 void store_clear(struct store *);
+int store_merge(struct store *, struct store *);
 void * store_malloc(struct store *, size_t);
 void * store_calloc(struct store *, size_t);
 char * store_strcpy(struct store *, char *, size_t);
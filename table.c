@@ -1,8 +1,88 @@
 #include "table.h"
 
+#include "stddef.h"
+#include "limits.h"
+
 int long_compare(void *, void *);
 int string_long(struct string *, long *);
 int string_store(struct string *, struct store *, char **);
+int string_true(struct string *);
+void * string_search(struct string *, struct map *);
+
+typedef int (* table_create_cb) (void *, size_t, struct heap *);
+typedef void (* table_destroy_cb) (void *);
+typedef int (* table_merge_cb) (void *, void *);
+typedef int (* table_parse_cb) (struct table *, char *);
+typedef int (* table_source_cb) (void *, struct chunk *);
+
+struct table_loader {
+    char * mark;
+    int * column;
+    struct schema_markup * markup;
+    parser_cb callback;
+    table_create_cb create;
+    table_destroy_cb destroy;
+    table_merge_cb merge;
+    table_source_cb source;
+};
+
+/*
+ * a mapped file whose records are kept as views
+ * until the table is destroyed
+ */
+struct table_file {
+    struct chunk chunk;
+    struct table_file * next;
+};
+
+struct table_task {
+    struct heap heap;
+    struct parser parser;
+    struct table_loader * loader;
+    union {
+        struct item item;
+        struct mob mob;
+        struct constant constant;
+    } object;
+};
+
+struct table_batch {
+    struct table * table;
+    struct table_loader * loader;
+    void * object;
+};
+
+int table_task_create(struct table_task *, struct table_loader *, size_t);
+void table_task_destroy(struct table_task *);
+int table_task_parse(struct chunk *, void *);
+int table_chunk_parse(struct table_loader *, struct parser *, struct chunk *, void *);
+int table_batch_parse(struct chunk *, void *);
+int table_keep(struct table *, struct chunk *);
+int table_load(struct table *, struct table_loader *, char *, void *);
+struct table_loader * table_item_loader(char *);
+int table_item_list(struct table *, char *);
+struct argument * table_argument_type(struct table *, enum table_type);
+int table_need(struct table *, enum table_type);
+int table_item_need(struct table *);
+int table_constant_need(struct table *);
+int table_index(struct map *, struct map *, size_t, int *);
+
+int item_column[] = { 1, 3, 20, 0 };
+int item_combo_column[] = { 1, 2, 0 };
+int mob_column[] = { 1, 2, 3, 0 };
+int mercenary_column[] = { 1, 3, 0 };
+
+struct schema_markup item_markup[] = {
+    {1, schema_map | schema_skip, 0, NULL},
+    {2, schema_list, 1, "Body"},
+    {3, schema_map | schema_skip, 2, NULL},
+    {4, schema_string, 3, "Id"},
+    {4, schema_string, 4, "Name"},
+    {4, schema_string, 5, "Script"},
+    {4, schema_string, 6, "EquipScript"},
+    {4, schema_string, 7, "UnEquipScript"},
+    {0, 0, 0}
+};
 
 struct schema_markup skill_markup[] = {
     {1, schema_map, 0, NULL},
@@ -35,6 +115,7 @@ struct schema_markup constant_group_markup[] = {
     {3, schema_list, 2, "group"},
     {4, schema_string, 3, NULL},
     {3, schema_string, 4, "identifier"},
+    {0, 0, 0}
 };
 
 struct schema_markup argument_markup[] = {
@@ -75,14 +156,22 @@ int long_compare(void * x, void * y) {
 int string_long(struct string * string, long * result) {
     int status = 0;
 
+    char buffer[32];
     char * last;
     long value;
 
-    value = strtol(string->string, &last, 0);
-    if(*last) {
-        status = panic("failed to strtol");
+    if(string->length >= sizeof(buffer)) {
+        status = panic("invalid string length - %zu", string->length);
     } else {
-        *result = value;
+        memcpy(buffer, string->string, string->length);
+        buffer[string->length] = 0;
+
+        value = strtol(buffer, &last, 0);
+        if(*last) {
+            status = panic("failed to strtol");
+        } else {
+            *result = value;
+        }
     }
 
     return status;
@@ -102,6 +191,26 @@ int string_store(struct string * string, struct store * store, char ** result) {
     return status;
 }
 
+int string_true(struct string * string) {
+    return string->length == 4 && !memcmp(string->string, "true", 4);
+}
+
+/*
+ * scalars are not terminated, copy the key
+ * for maps that compare with strcasecmp
+ */
+void * string_search(struct string * string, struct map * map) {
+    char buffer[256];
+
+    if(string->length >= sizeof(buffer))
+        return NULL;
+
+    memcpy(buffer, string->string, string->length);
+    buffer[string->length] = 0;
+
+    return map_search(map, buffer);
+}
+
 int item_create(struct item * item, size_t size, struct heap * heap) {
     int status = 0;
 
@@ -119,6 +228,9 @@ int item_create(struct item * item, size_t size, struct heap * heap) {
     } else if(map_create(&item->name, (map_compare_cb) strcmp, heap->map_pool)) {
         status = panic("failed to create map object");
         goto name_fail;
+    } else {
+        item->stale = 0;
+        item->view = 0;
     }
 
     return status;
@@ -143,6 +255,20 @@ void item_destroy(struct item * item) {
     store_destroy(&item->store);
 }
 
+int item_merge(struct item * item, struct item * from) {
+    int status = 0;
+
+    if(map_merge(&item->id, &from->id)) {
+        status = panic("failed to merge map object");
+    } else if(store_merge(&item->store, &from->store)) {
+        status = panic("failed to merge store object");
+    } else {
+        item->stale = 1;
+    }
+
+    return status;
+}
+
 int item_parse(enum parser_type type, int mark, struct string * string, void * context) {
     struct item * item = context;
 
@@ -153,30 +279,102 @@ int item_parse(enum parser_type type, int mark, struct string * string, void * c
                 if(!item->item)
                     return panic("failed to calloc store object");
             } else if(type == parser_end) {
-                if(map_insert(&item->id, &item->item->id, item->item)) {
-                    return panic("failed to insert map object");
-                } else if(map_insert(&item->name, item->item->name, item->item)) {
+                if(map_insert(&item->id, &item->item->id, item->item))
                     return panic("failed to insert map object");
-                }
+
+                item->stale = 1;
             }
             break;
         case 1: return string_long(string, &item->item->id); break;
         case 3: return string_store(string, &item->store, &item->item->name); break;
         case 20:
-            if(item_script_parse(item, string->string))
+            if(item->view) {
+                item->item->script = *string;
+            } else if(item_script_parse(item, item->item, string->string, string->length)) {
                 return panic("failed to script parse item object");
+            }
+            break;
+    }
+
+    return 0;
+}
+
+/*
+ * the script is kept as a view when the source
+ * outlives the table, otherwise it is copied; an
+ * item_db.yml is only known by its extension so a
+ * yaml document read as csv is refused here
+ */
+int item_source(struct item * item, struct chunk * chunk) {
+    char * iter;
+
+    iter = chunk->begin;
+    while(iter < chunk->end && isspace(*iter))
+        iter++;
+
+    if(iter < chunk->end && (isalpha(*iter) || *iter == '#'))
+        return panic("item_db yaml must be given as a .yml or .yaml path");
+
+    item->view = chunk->keep;
+    return 0;
+}
+
+/*
+ * the scripts of item_db.yml are not in braces
+ */
+int item_yaml_parse(enum parser_type type, int mark, struct string * string, void * context) {
+    struct item * item = context;
+
+    switch(mark) {
+        case 2:
+            if(type == parser_start) {
+                item->item = store_calloc(&item->store, sizeof(*item->item));
+                if(!item->item)
+                    return panic("failed to calloc store object");
+            } else if(type == parser_end) {
+                if(!item->item->bonus) {
+                    item->item->bonus = store_strcpy(&item->store, "{}", 2);
+                    if(!item->item->bonus)
+                        return panic("failed to strcpy store object");
+                }
+
+                if(map_insert(&item->id, &item->item->id, item->item))
+                    return panic("failed to insert map object");
+
+                item->stale = 1;
+            }
             break;
+        case 3: return string_long(string, &item->item->id); break;
+        case 4: return string_store(string, &item->store, &item->item->name); break;
+        case 5: return item_yaml_script(item, string, &item->item->bonus); break;
+        case 6: return item_yaml_script(item, string, &item->item->equip); break;
+        case 7: return item_yaml_script(item, string, &item->item->unequip); break;
     }
 
     return 0;
 }
 
-int item_script_parse(struct item * item, char * string) {
+int item_yaml_script(struct item * item, struct string * string, char ** result) {
+    int status = 0;
+    char * object;
+
+    object = store_printf(&item->store, "{%.*s}", (int) string->length, string->string);
+    if(!object) {
+        status = panic("failed to printf store object");
+    } else {
+        *result = object;
+    }
+
+    return status;
+}
+
+int item_script_parse(struct item * item, struct item_node * node, char * string, size_t length) {
     int curly = 0;
     size_t index = 0;
     char * anchor = NULL;
+    char * end = string + length;
 
-    while(*string) {
+    while(string < end) {
         if(*string == '{') {
             if(!curly)
                 anchor = string;
@@ -186,18 +384,18 @@ int item_script_parse(struct item * item, char * string) {
             if(!curly) {
                 switch(index) {
                     case 0:
-                        item->item->bonus = store_strcpy(&item->store, anchor, string - anchor + 1);
-                        if(!item->item->bonus)
+                        node->bonus = store_strcpy(&item->store, anchor, string - anchor + 1);
+                        if(!node->bonus)
                             return panic("failed to char store object");
                         break;
                     case 1:
-                        item->item->equip = store_strcpy(&item->store, anchor, string - anchor + 1);
-                        if(!item->item->equip)
+                        node->equip = store_strcpy(&item->store, anchor, string - anchor + 1);
+                        if(!node->equip)
                             return panic("failed to char store object");
                         break;
                     case 2:
-                        item->item->unequip = store_strcpy(&item->store, anchor, string - anchor + 1);
-                        if(!item->item->unequip)
+                        node->unequip = store_strcpy(&item->store, anchor, string - anchor + 1);
+                        if(!node->unequip)
                             return panic("failed to char store object");
                         break;
                 }
@@ -292,8 +490,11 @@ int skill_create(struct skill * skill, size_t size, struct heap * heap) {
         if(map_create(&skill->id, long_compare, heap->map_pool)) {
             status = panic("failed to create map object");
         } else {
-            if(map_create(&skill->name, (map_compare_cb) strcmp, heap->map_pool))
+            if(map_create(&skill->name, (map_compare_cb) strcmp, heap->map_pool)) {
                 status = panic("failed to create map object");
+            } else {
+                skill->stale = 0;
+            }
             if(status)
                 map_destroy(&skill->id);
         }
@@ -324,9 +525,9 @@ int skill_parse(enum parser_type type, int mark, struct string * string, void *
                     return panic("invalid name");
                 } else if(map_insert(&skill->id, &skill->skill->id, skill->skill)) {
                     return panic("failed to insert map object");
-                } else if(map_insert(&skill->name, skill->skill->name, skill->skill)) {
-                    return panic("failed to insert map object");
                 }
+
+                skill->stale = 1;
             }
             break;
         case 3: return string_long(string, &skill->skill->id); break;
@@ -347,8 +548,11 @@ int mob_create(struct mob * mob, size_t size, struct heap * heap) {
         if(map_create(&mob->id, long_compare, heap->map_pool)) {
             status = panic("failed to create map object");
         } else {
-            if(map_create(&mob->sprite, (map_compare_cb) strcmp, heap->map_pool))
+            if(map_create(&mob->sprite, (map_compare_cb) strcmp, heap->map_pool)) {
                 status = panic("failed to create map object");
+            } else {
+                mob->stale = 0;
+            }
             if(status)
                 map_destroy(&mob->id);
         }
@@ -365,6 +569,20 @@ void mob_destroy(struct mob * mob) {
     store_destroy(&mob->store);
 }
 
+int mob_merge(struct mob * mob, struct mob * from) {
+    int status = 0;
+
+    if(map_merge(&mob->id, &from->id)) {
+        status = panic("failed to merge map object");
+    } else if(store_merge(&mob->store, &from->store)) {
+        status = panic("failed to merge store object");
+    } else {
+        mob->stale = 1;
+    }
+
+    return status;
+}
+
 int mob_parse(enum parser_type type, int mark, struct string * string, void * context) {
     struct mob * mob = context;
 
@@ -375,11 +593,10 @@ int mob_parse(enum parser_type type, int mark, struct string * string, void * co
                 if(!mob->mob)
                     return panic("failed to calloc store object");
             } else if(type == parser_end) {
-                if(map_insert(&mob->id, &mob->mob->id, mob->mob)) {
+                if(map_insert(&mob->id, &mob->mob->id, mob->mob))
                     return panic("failed to insert map object");
-                } else if(map_insert(&mob->sprite, mob->mob->sprite, mob->mob)) {
-                    return panic("failed to insert map object");
-                }
+
+                mob->stale = 1;
             }
             break;
         case 1: return string_long(string, &mob->mob->id); break;
@@ -470,6 +687,20 @@ void constant_destroy(struct constant * constant) {
     store_destroy(&constant->store);
 }
 
+int constant_merge(struct constant * constant, struct constant * from) {
+    int status = 0;
+
+    if(from->constant_group) {
+        status = panic("invalid constant group");
+    } else if(map_merge(&constant->identifier, &from->identifier)) {
+        status = panic("failed to merge map object");
+    } else if(store_merge(&constant->store, &from->store)) {
+        status = panic("failed to merge store object");
+    }
+
+    return status;
+}
+
 struct constant_group_node * constant_group(struct constant * constant) {
     int status = 0;
     struct constant_group_node * group;
@@ -522,9 +753,9 @@ int constant_data_parse(enum parser_type type, int mark, struct string * string,
                 constant->constant = NULL;
             break;
         case 2:
-            constant->constant = map_search(&constant->identifier, string->string);
+            constant->constant = string_search(string, &constant->identifier);
             if(!constant->constant)
-                return panic("failed to search map object - %s", string->string);
+                return panic("failed to search map object - %.*s", (int) string->length, string->string);
             break;
         case 4: return string_store(string, &constant->store, &constant->constant->tag); break;
         case 6:
@@ -540,7 +771,7 @@ int constant_data_parse(enum parser_type type, int mark, struct string * string,
         case 7: return string_long(string, &constant->range->min); break;
         case 8: return string_long(string, &constant->range->max); break;
         case 9:
-            if(!strcmp(string->string, "true"))
+            if(string_true(string))
                 constant->constant->variable = 1;
             break;
     }
@@ -567,9 +798,9 @@ int constant_group_parse(enum parser_type type, int mark, struct string * string
             }
             break;
         case 3:
-            node = map_search(&constant->identifier, string->string);
+            node = string_search(string, &constant->identifier);
             if(!node) {
-                return panic("invalid constant - %s", string->string);
+                return panic("invalid constant - %.*s", (int) string->length, string->string);
             } else if(!node->tag) {
                 return panic("invalid tag - %s", node->identifier);
             } else if(map_insert(&group->map_identifier, node->identifier, node)) {
@@ -716,23 +947,23 @@ int argument_parse(enum parser_type type, int mark, struct string * string, void
             }
             break;
         case 16:
-            if(!strcmp("true", string->string))
+            if(string_true(string))
                 argument->integer->flag |= integer_sign;
             break;
         case 17:
-            if(!strcmp("true", string->string))
+            if(string_true(string))
                 argument->integer->flag |= integer_string;
             break;
         case 18:
-            if(!strcmp("true", string->string))
+            if(string_true(string))
                 argument->integer->flag |= integer_percent;
             break;
         case 19:
-            if(!strcmp("true", string->string))
+            if(string_true(string))
                 argument->integer->flag |= integer_inverse;
             break;
         case 20:
-            if(!strcmp("true", string->string))
+            if(string_true(string))
                 argument->integer->flag |= integer_absolute;
             break;
         case 21: return string_long(string, &argument->integer->divide); break;
@@ -756,12 +987,13 @@ int argument_parse(enum parser_type type, int mark, struct string * string, void
 int argument_entry_parse(struct argument * argument, char * string, size_t length) {
     char * anchor;
     char * cursor;
+    char * end = string + length;
     struct entry_node * entry;
 
     argument->entry = NULL;
 
     anchor = string;
-    cursor = strchr(anchor, '{');
+    cursor = memchr(anchor, '{', end - anchor);
     while(cursor) {
         if(argument_entry_create(argument, anchor, cursor - anchor))
             return panic("failed to entry push argument object");
@@ -780,7 +1012,7 @@ int argument_entry_parse(struct argument * argument, char * string, size_t lengt
             return panic("expected vertical bar");
 
         anchor = cursor + 1;
-        cursor = strchr(anchor, '}');
+        cursor = memchr(anchor, '}', end - anchor);
         if(!cursor)
             return panic("expected curly close");
 
@@ -789,10 +1021,10 @@ int argument_entry_parse(struct argument * argument, char * string, size_t lengt
             return panic("failed to strcpy store object");
 
         anchor = cursor + 1;
-        cursor = strchr(anchor, '{');
+        cursor = memchr(anchor, '{', end - anchor);
     }
 
-    if(argument_entry_create(argument, anchor, (string + length) - anchor))
+    if(argument_entry_create(argument, anchor, end - anchor))
         return panic("failed to entry push argument object");
 
     return 0;
@@ -826,6 +1058,13 @@ int argument_entry_create(struct argument * argument, char * string, size_t leng
 int table_create(struct table * table, size_t size, struct heap * heap) {
     int status = 0;
 
+    table->size = size;
+    table->status = 0;
+    memset(table->path, 0, sizeof(table->path));
+    table->file = NULL;
+    table->link = NULL;
+    table->context = NULL;
+
     if(parser_create(&table->parser, size)) {
         status = panic("failed to create parser object");
     } else if(item_create(&table->item, size, heap)) {
@@ -912,6 +1151,8 @@ item_fail:
 }
 
 void table_destroy(struct table * table) {
+    struct table_file * node;
+
     argument_destroy(&table->statement);
     argument_destroy(&table->sc_start4);
     argument_destroy(&table->sc_start2);
@@ -928,14 +1169,273 @@ void table_destroy(struct table * table) {
     skill_destroy(&table->skill);
     item_destroy(&table->item);
     parser_destroy(&table->parser);
+
+    while(table->file) {
+        node = table->file;
+        table->file = table->file->next;
+        chunk_unmap(&node->chunk);
+        free(node);
+    }
+}
+
+struct table_loader item_loader = {
+    "", item_column, NULL, item_parse,
+    (table_create_cb) item_create, (table_destroy_cb) item_destroy, (table_merge_cb) item_merge,
+    (table_source_cb) item_source
+};
+
+struct table_loader item_yaml_loader = {
+    NULL, NULL, item_markup, item_yaml_parse,
+    (table_create_cb) item_create, (table_destroy_cb) item_destroy, (table_merge_cb) item_merge,
+    NULL
+};
+
+struct table_loader mob_loader = {
+    "", mob_column, NULL, mob_parse,
+    (table_create_cb) mob_create, (table_destroy_cb) mob_destroy, (table_merge_cb) mob_merge,
+    NULL
+};
+
+struct table_loader constant_loader = {
+    "- ", NULL, constant_markup, constant_parse,
+    (table_create_cb) constant_create, (table_destroy_cb) constant_destroy, (table_merge_cb) constant_merge,
+    NULL
+};
+
+int table_task_create(struct table_task * task, struct table_loader * loader, size_t size) {
+    int status = 0;
+
+    task->loader = loader;
+
+    if(heap_create(&task->heap, size)) {
+        status = panic("failed to create heap object");
+    } else if(parser_create(&task->parser, size)) {
+        status = panic("failed to create parser object");
+        goto parser_fail;
+    } else if(loader->create(&task->object, size, &task->heap)) {
+        status = panic("failed to create object");
+        goto object_fail;
+    }
+
+    return status;
+
+object_fail:
+    parser_destroy(&task->parser);
+parser_fail:
+    heap_destroy(&task->heap);
+
+    return status;
+}
+
+void table_task_destroy(struct table_task * task) {
+    task->loader->destroy(&task->object);
+    parser_destroy(&task->parser);
+    heap_destroy(&task->heap);
 }
 
+int table_task_parse(struct chunk * chunk, void * context) {
+    struct table_task * task = context;
+
+    return table_chunk_parse(task->loader, &task->parser, chunk, &task->object);
+}
+
+int table_chunk_parse(struct table_loader * loader, struct parser * parser, struct chunk * chunk, void * object) {
+    if(loader->source && loader->source(object, chunk))
+        return panic("failed to source object");
+
+    if(loader->markup)
+        return parser_chunk(parser, loader->markup, chunk, loader->callback, object);
+
+    return csv_chunk(chunk, loader->column, loader->callback, object);
+}
+
+/*
+ * split a batch of whole records and parse the parts into
+ * per task objects on separate threads, then merge them in
+ * file order so a duplicate key keeps the later record
+ */
+int table_batch_parse(struct chunk * file, void * context) {
+    int status = 0;
+
+    size_t i = 0;
+    size_t j;
+    size_t count = CHUNK_COUNT;
+    struct table_batch * batch = context;
+    struct table_loader * loader = batch->loader;
+    struct chunk chunk[CHUNK_COUNT];
+    struct table_task task[CHUNK_COUNT];
+
+    if(loader->source && file->mapped && table_keep(batch->table, file)) {
+        status = panic("failed to keep chunk object");
+    } else if(chunk_split(file, loader->mark, chunk, &count)) {
+        status = panic("failed to split chunk object");
+    } else if(count < 2) {
+        if(table_chunk_parse(loader, &batch->table->parser, file, batch->object))
+            status = panic("failed to parse chunk object");
+    } else {
+        while(i < count && !status) {
+            if(table_task_create(&task[i], loader, batch->table->size)) {
+                status = panic("failed to create task object");
+            } else {
+                chunk[i].context = &task[i];
+                i++;
+            }
+        }
+
+        if(!status) {
+            if(chunk_run(chunk, count, table_task_parse)) {
+                status = panic("failed to run chunk object");
+            } else {
+                for(j = 0; j < count && !status; j++)
+                    if(loader->merge(batch->object, &task[j].object))
+                        status = panic("failed to merge object");
+            }
+        }
+
+        while(i > 0)
+            table_task_destroy(&task[--i]);
+    }
+
+    return status;
+}
+
+/*
+ * take the mapping of file so that views into it
+ * stay valid while the table exists
+ */
+int table_keep(struct table * table, struct chunk * file) {
+    int status = 0;
+    struct table_file * node;
+
+    node = malloc(sizeof(*node));
+    if(!node) {
+        status = panic("out of memory");
+    } else {
+        file->keep = 1;
+        node->chunk = *file;
+        node->next = table->file;
+        table->file = node;
+    }
+
+    return status;
+}
+
+int table_load(struct table * table, struct table_loader * loader, char * path, void * object) {
+    int status = 0;
+
+    char * ext;
+    struct table_batch batch;
+
+    /* json records do not start at a line mark */
+    ext = strrchr(path, '.');
+    if(loader->markup && ext && !strcmp(ext, ".json")) {
+        if(parser_file(&table->parser, loader->markup, path, loader->callback, object))
+            status = panic("failed to parse %s", path);
+    } else {
+        batch.table = table;
+        batch.loader = loader;
+        batch.object = object;
+
+        if(chunk_stream(path, loader->mark, table_batch_parse, &batch))
+            status = panic("failed to parse %s", path);
+    }
+
+    return status;
+}
+
+/*
+ * path is a comma separated list of item_db.txt
+ * and item_db.yml files, later files win
+ */
 int table_item_parse(struct table * table, char * path) {
-    return csv_parse(path, item_parse, &table->item);
+    if(!strchr(path, ',') && table_item_loader(path) == &item_loader)
+        return table_load(table, &item_loader, path, &table->item);
+
+    return table_item_list(table, path);
+}
+
+struct table_loader * table_item_loader(char * path) {
+    char * ext;
+
+    ext = strrchr(path, '.');
+    if(ext && (!strcmp(ext, ".yml") || !strcmp(ext, ".yaml")))
+        return &item_yaml_loader;
+
+    return &item_loader;
+}
+
+/*
+ * parse up to CHUNK_COUNT files at a time, each whole
+ * into its own task on a separate thread, and merge
+ * the tasks in list order
+ */
+int table_item_list(struct table * table, char * path) {
+    int status = 0;
+
+    size_t i;
+    size_t j;
+    size_t length;
+    char * iter;
+    char * next;
+    char name[PATH_MAX];
+    struct table_loader * loader;
+    struct chunk chunk[CHUNK_COUNT];
+    struct table_task task[CHUNK_COUNT];
+
+    iter = path;
+    while(iter && !status) {
+        i = 0;
+        while(iter && i < CHUNK_COUNT && !status) {
+            next = strchr(iter, ',');
+            length = next ? (size_t) (next - iter) : strlen(iter);
+            if(length >= sizeof(name)) {
+                status = panic("invalid path - %s", path);
+            } else {
+                memcpy(name, iter, length);
+                name[length] = 0;
+
+                loader = table_item_loader(name);
+                if(chunk_map(&chunk[i], name)) {
+                    status = panic("failed to map %s", name);
+                } else if(loader->source && chunk[i].mapped && table_keep(table, &chunk[i])) {
+                    status = panic("failed to keep chunk object");
+                    chunk_unmap(&chunk[i]);
+                } else if(table_task_create(&task[i], loader, table->size)) {
+                    status = panic("failed to create task object");
+                    if(!chunk[i].keep)
+                        chunk_unmap(&chunk[i]);
+                } else {
+                    chunk[i].context = &task[i];
+                    i++;
+                }
+
+                iter = next ? next + 1 : NULL;
+            }
+        }
+
+        if(!status) {
+            if(chunk_run(chunk, i, table_task_parse)) {
+                status = panic("failed to run chunk object");
+            } else {
+                for(j = 0; j < i && !status; j++)
+                    if(item_merge(&table->item, &task[j].object.item))
+                        status = panic("failed to merge item object");
+            }
+        }
+
+        while(i > 0) {
+            i--;
+            table_task_destroy(&task[i]);
+            if(!chunk[i].keep)
+                chunk_unmap(&chunk[i]);
+        }
+    }
+
+    return status;
 }
 
 int table_item_combo_parse(struct table * table, char * path) {
-    return csv_parse(path, item_combo_parse, &table->item);
+    return csv_parse(path, item_combo_column, item_combo_parse, &table->item);
 }
 
 int table_skill_parse(struct table * table, char * path) {
@@ -943,15 +1443,15 @@ int table_skill_parse(struct table * table, char * path) {
 }
 
 int table_mob_parse(struct table * table, char * path) {
-    return csv_parse(path, mob_parse, &table->mob);
+    return table_load(table, &mob_loader, path, &table->mob);
 }
 
 int table_mercenary_parse(struct table * table, char * path) {
-    return csv_parse(path, mercenary_parse, &table->mercenary);
+    return csv_parse(path, mercenary_column, mercenary_parse, &table->mercenary);
 }
 
 int table_constant_parse(struct table * table, char * path) {
-    return parser_file(&table->parser, constant_markup, path, constant_parse, &table->constant);
+    return table_load(table, &constant_loader, path, &table->constant);
 }
 
 int table_constant_data_parse(struct table * table, char * path) {
@@ -1002,86 +1502,306 @@ int table_statement_parse(struct table * table, char * path) {
     return parser_file(&table->parser, argument_markup, path, argument_parse, &table->statement);
 }
 
+table_parse_cb table_parse[] = {
+    [table_item] = table_item_parse,
+    [table_item_combo] = table_item_combo_parse,
+    [table_skill] = table_skill_parse,
+    [table_mob] = table_mob_parse,
+    [table_mercenary] = table_mercenary_parse,
+    [table_constant] = table_constant_parse,
+    [table_constant_data] = table_constant_data_parse,
+    [table_constant_group] = table_constant_group_parse,
+    [table_argument] = table_argument_parse,
+    [table_bonus] = table_bonus_parse,
+    [table_bonus2] = table_bonus2_parse,
+    [table_bonus3] = table_bonus3_parse,
+    [table_bonus4] = table_bonus4_parse,
+    [table_bonus5] = table_bonus5_parse,
+    [table_sc_start] = table_sc_start_parse,
+    [table_sc_start2] = table_sc_start2_parse,
+    [table_sc_start4] = table_sc_start4_parse,
+    [table_statement] = table_statement_parse
+};
+
+void table_path(struct table * table, enum table_type type, char * path) {
+    table->path[type] = path;
+}
+
+/*
+ * set the callback that is called on each argument table
+ * after it is parsed; the argument tables that are parsed
+ * already are linked now
+ */
+int table_link(struct table * table, table_link_cb link, void * context) {
+    int type;
+    struct argument * argument;
+
+    table->link = link;
+    table->context = context;
+
+    if(link && !table->status) {
+        for(type = 0; type < table_count && !table->status; type++) {
+            argument = table_argument_type(table, type);
+            if(argument && !table->path[type] && link(argument, context))
+                table->status = panic("failed to link argument object");
+        }
+    }
+
+    return table->status;
+}
+
+struct argument * table_argument_type(struct table * table, enum table_type type) {
+    switch(type) {
+        case table_argument: return &table->argument;
+        case table_bonus: return &table->bonus;
+        case table_bonus2: return &table->bonus2;
+        case table_bonus3: return &table->bonus3;
+        case table_bonus4: return &table->bonus4;
+        case table_bonus5: return &table->bonus5;
+        case table_sc_start: return &table->sc_start;
+        case table_sc_start2: return &table->sc_start2;
+        case table_sc_start4: return &table->sc_start4;
+        case table_statement: return &table->statement;
+        default: return NULL;
+    }
+}
+
+/*
+ * parse the table of type if its path is set and it has not
+ * been parsed yet; a failure is kept so that every access
+ * after it fails too
+ */
+int table_need(struct table * table, enum table_type type) {
+    char * path;
+    struct argument * argument;
+
+    path = table->path[type];
+    if(path && !table->status) {
+        table->path[type] = NULL;
+        if(table_parse[type](table, path)) {
+            table->status = panic("failed to load %s", path);
+        } else if(table->link) {
+            argument = table_argument_type(table, type);
+            if(argument && table->link(argument, table->context))
+                table->status = panic("failed to link %s", path);
+        }
+    }
+
+    return table->status;
+}
+
+int table_item_need(struct table * table) {
+    return table_need(table, table_item) || table_need(table, table_item_combo);
+}
+
+int table_constant_need(struct table * table) {
+    return table_need(table, table_constant) || table_need(table, table_constant_data) || table_need(table, table_constant_group);
+}
+
+/*
+ * rebuild index, a map of the records of id by the string at
+ * offset, after records were added; the iterator of id is kept
+ * since it may be walked while the index is searched
+ */
+int table_index(struct map * index, struct map * id, size_t offset, int * stale) {
+    int status = 0;
+
+    char * key;
+    struct map_kv kv;
+    struct map_node * iter;
+
+    if(*stale) {
+        iter = id->iter;
+        map_clear(index);
+
+        kv = map_start(id);
+        while(kv.key && !status) {
+            key = *(char **) ((char *) kv.value + offset);
+            if(key && map_insert(index, key, kv.value)) {
+                status = panic("failed to insert map object");
+            } else {
+                kv = map_next(id);
+            }
+        }
+
+        id->iter = iter;
+        if(!status)
+            *stale = 0;
+    }
+
+    return status;
+}
+
 struct item_node * item_start(struct table * table) {
+    if(table_item_need(table))
+        return NULL;
+
     return map_start(&table->item.id).value;
 }
 
 struct item_node * item_next(struct table * table) {
+    if(table_item_need(table))
+        return NULL;
+
     return map_next(&table->item.id).value;
 }
 
 struct item_node * item_id(struct table * table, long id) {
+    if(table_item_need(table))
+        return NULL;
+
     return map_search(&table->item.id, &id);
 }
 
 struct item_node * item_name(struct table * table, char * name) {
+    if(table_item_need(table))
+        return NULL;
+
+    if(table_index(&table->item.name, &table->item.id, offsetof(struct item_node, name), &table->item.stale))
+        return NULL;
+
     return map_search(&table->item.name, name);
 }
 
+/*
+ * copy the bonus, equip and unequip scripts
+ * out of the source on first use
+ */
+int item_script(struct table * table, struct item_node * item) {
+    int status = 0;
+
+    if(item->script.string) {
+        if(item_script_parse(&table->item, item, item->script.string, item->script.length)) {
+            status = panic("failed to script parse item object");
+        } else {
+            item->script.string = NULL;
+        }
+    }
+
+    return status;
+}
+
 struct skill_node * skill_id(struct table * table, long id) {
+    if(table_need(table, table_skill))
+        return NULL;
+
     return map_search(&table->skill.id, &id);
 }
 
 struct skill_node * skill_name(struct table * table, char * name) {
+    if(table_need(table, table_skill))
+        return NULL;
+
+    if(table_index(&table->skill.name, &table->skill.id, offsetof(struct skill_node, name), &table->skill.stale))
+        return NULL;
+
     return map_search(&table->skill.name, name);
 }
 
 struct mob_node * mob_id(struct table * table, long id) {
+    if(table_need(table, table_mob))
+        return NULL;
+
     return map_search(&table->mob.id, &id);
 }
 
 struct mob_node * mob_sprite(struct table * table, char * sprite) {
+    if(table_need(table, table_mob))
+        return NULL;
+
+    if(table_index(&table->mob.sprite, &table->mob.id, offsetof(struct mob_node, sprite), &table->mob.stale))
+        return NULL;
+
     return map_search(&table->mob.sprite, sprite);
 }
 
 struct mercenary_node * mercenary_id(struct table * table, long id) {
+    if(table_need(table, table_mercenary))
+        return NULL;
+
     return map_search(&table->mercenary.id, &id);
 }
 
 struct constant_node * constant_identifier(struct table * table, char * identifier) {
+    if(table_constant_need(table))
+        return NULL;
+
     return map_search(&table->constant.identifier, identifier);
 }
 
 struct constant_group_node * constant_group_identifier(struct table * table, char * identifier) {
+    if(table_constant_need(table))
+        return NULL;
+
     return map_search(&table->constant.group, identifier);
 }
 
 struct argument_node * argument_identifier(struct table * table, char * identifier) {
+    if(table_need(table, table_argument))
+        return NULL;
+
     return map_search(&table->argument.identifier, identifier);
 }
 
 struct argument_node * bonus_identifier(struct table * table, char * identifier) {
+    if(table_need(table, table_bonus))
+        return NULL;
+
     return map_search(&table->bonus.identifier, identifier);
 }
 
 struct argument_node * bonus2_identifier(struct table * table, char * identifier) {
+    if(table_need(table, table_bonus2))
+        return NULL;
+
     return map_search(&table->bonus2.identifier, identifier);
 }
 
 struct argument_node * bonus3_identifier(struct table * table, char * identifier) {
+    if(table_need(table, table_bonus3))
+        return NULL;
+
     return map_search(&table->bonus3.identifier, identifier);
 }
 
 struct argument_node * bonus4_identifier(struct table * table, char * identifier) {
+    if(table_need(table, table_bonus4))
+        return NULL;
+
     return map_search(&table->bonus4.identifier, identifier);
 }
 
 struct argument_node * bonus5_identifier(struct table * table, char * identifier) {
+    if(table_need(table, table_bonus5))
+        return NULL;
+
     return map_search(&table->bonus5.identifier, identifier);
 }
 
 struct argument_node * sc_start_identifier(struct table * table, char * identifier) {
+    if(table_need(table, table_sc_start))
+        return NULL;
+
     return map_search(&table->sc_start.identifier, identifier);
 }
 
 struct argument_node * sc_start2_identifier(struct table * table, char * identifier) {
+    if(table_need(table, table_sc_start2))
+        return NULL;
+
     return map_search(&table->sc_start2.identifier, identifier);
 }
 
 struct argument_node * sc_start4_identifier(struct table * table, char * identifier) {
+    if(table_need(table, table_sc_start4))
+        return NULL;
+
     return map_search(&table->sc_start4.identifier, identifier);
 }
 
 struct argument_node * statement_identifier(struct table * table, char * identifier) {
+    if(table_need(table, table_statement))
+        return NULL;
+
     return map_search(&table->statement.identifier, identifier);
 }
@@ -14,6 +14,7 @@ struct item_combo_node {
 struct item_node {
     long id;
     char * name;
+    struct string script;
     char * bonus;
     char * equip;
     char * unequip;
@@ -26,13 +27,19 @@ struct item {
     struct strbuf strbuf;
     struct map id;
     struct map name;
+    int stale;
+    int view;
     struct item_node * item;
 };
 
 int item_create(struct item *, size_t, struct heap *);
 void item_destroy(struct item *);
+int item_merge(struct item *, struct item *);
 int item_parse(enum parser_type, int, struct string *, void *);
-int item_script_parse(struct item *, char *);
+int item_yaml_parse(enum parser_type, int, struct string *, void *);
+int item_yaml_script(struct item *, struct string *, char **);
+int item_source(struct item *, struct chunk *);
+int item_script_parse(struct item *, struct item_node *, char *, size_t);
 int item_combo_parse(enum parser_type, int, struct string *, void *);
 
 struct skill_node {
@@ -46,6 +53,7 @@ struct skill {
     struct store store;
     struct map id;
     struct map name;
+    int stale;
     struct skill_node * skill;
 };
 
@@ -63,11 +71,13 @@ struct mob {
     struct store store;
     struct map id;
     struct map sprite;
+    int stale;
     struct mob_node * mob;
 };
 
 int mob_create(struct mob *, size_t, struct heap *);
 void mob_destroy(struct mob *);
+int mob_merge(struct mob *, struct mob *);
 int mob_parse(enum parser_type, int, struct string *, void *);
 
 struct mercenary_node {
@@ -111,6 +121,7 @@ struct constant {
 
 int constant_create(struct constant *, size_t, struct heap *);
 void constant_destroy(struct constant *);
+int constant_merge(struct constant *, struct constant *);
 struct constant_group_node * constant_group(struct constant *);
 int constant_parse(enum parser_type, int, struct string *, void *);
 int constant_data_parse(enum parser_type, int, struct string *, void *);
@@ -151,6 +162,8 @@ struct entry_node {
     long array[ENTRY_MAX];
     size_t count;
     char * identifier;
+    void * callback;
+    struct argument_node * argument;
     size_t length;
     char * string;
     struct entry_node * next;
@@ -159,6 +172,7 @@ struct entry_node {
 struct argument_node {
     char * identifier;
     char * handler;
+    void * callback;
     struct print_node * print;
     struct range_node * range;
     struct map * map;
@@ -185,7 +199,42 @@ int argument_parse(enum parser_type, int, struct string *, void *);
 int argument_entry_parse(struct argument *, char *, size_t);
 int argument_entry_create(struct argument *, char *, size_t);
 
+/*
+ * a table whose path is set is parsed on first access
+ */
+enum table_type {
+    table_item,
+    table_item_combo,
+    table_skill,
+    table_mob,
+    table_mercenary,
+    table_constant,
+    table_constant_data,
+    table_constant_group,
+    table_argument,
+    table_bonus,
+    table_bonus2,
+    table_bonus3,
+    table_bonus4,
+    table_bonus5,
+    table_sc_start,
+    table_sc_start2,
+    table_sc_start4,
+    table_statement,
+    table_count
+};
+
+struct table_file;
+
+typedef int (* table_link_cb) (struct argument *, void *);
+
 struct table {
+    size_t size;
+    int status;
+    char * path[table_count];
+    struct table_file * file;
+    table_link_cb link;
+    void * context;
     struct parser parser;
     struct item item;
     struct skill skill;
@@ -206,6 +255,8 @@ struct table {
 
 int table_create(struct table *, size_t, struct heap *);
 void table_destroy(struct table *);
+void table_path(struct table *, enum table_type, char *);
+int table_link(struct table *, table_link_cb, void *);
 int table_item_parse(struct table *, char *);
 int table_item_combo_parse(struct table *, char *);
 int table_skill_parse(struct table *, char *);
@@ -229,6 +280,7 @@ struct item_node * item_start(struct table *);
 struct item_node * item_next(struct table *);
 struct item_node * item_id(struct table *, long);
 struct item_node * item_name(struct table *, char *);
+int item_script(struct table *, struct item_node *);
 
 struct skill_node * skill_id(struct table *, long);
 struct skill_node * skill_name(struct table *, char *);
@@ -0,0 +1,82 @@
+#include "vector.h"
+
+int vector_grow(struct vector *);
+
+int vector_create(struct vector * vector) {
+    vector->array = vector->buffer;
+    vector->count = 0;
+    vector->total = VECTOR_SIZE;
+    vector->index = 0;
+
+    return 0;
+}
+
+void vector_destroy(struct vector * vector) {
+    if(vector->array != vector->buffer)
+        free(vector->array);
+
+    vector->array = vector->buffer;
+    vector->count = 0;
+    vector->total = VECTOR_SIZE;
+}
+
+void vector_clear(struct vector * vector) {
+    vector->count = 0;
+}
+
+int vector_grow(struct vector * vector) {
+    int status = 0;
+    size_t total;
+    void ** array;
+
+    total = vector->total * 2;
+    if(vector->array == vector->buffer) {
+        array = malloc(total * sizeof(*array));
+        if(array)
+            memcpy(array, vector->buffer, vector->count * sizeof(*array));
+    } else {
+        array = realloc(vector->array, total * sizeof(*array));
+    }
+
+    if(!array) {
+        status = panic("out of memory");
+    } else {
+        vector->array = array;
+        vector->total = total;
+    }
+
+    return status;
+}
+
+int vector_push(struct vector * vector, void * object) {
+    if(!object) {
+        return panic("invalid object");
+    } else if(vector->count >= vector->total && vector_grow(vector)) {
+        return panic("failed to grow vector object");
+    } else {
+        vector->array[vector->count++] = object;
+    }
+
+    return 0;
+}
+
+void * vector_pop(struct vector * vector) {
+    return vector->count ? vector->array[--vector->count] : NULL;
+}
+
+void * vector_top(struct vector * vector) {
+    return vector->count ? vector->array[vector->count - 1] : NULL;
+}
+
+void * vector_get(struct vector * vector, size_t index) {
+    return index < vector->count ? vector->array[index] : NULL;
+}
+
+void * vector_start(struct vector * vector) {
+    vector->index = 0;
+    return vector_next(vector);
+}
+
+void * vector_next(struct vector * vector) {
+    return vector->index < vector->count ? vector->array[vector->index++] : NULL;
+}
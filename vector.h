@@ -0,0 +1,26 @@
+#ifndef vector_h
+#define vector_h
+
+#include "utility.h"
+
+#define VECTOR_SIZE 8
+
+struct vector {
+    void ** array;
+    size_t count;
+    size_t total;
+    size_t index;
+    void * buffer[VECTOR_SIZE];
+};
+
+int vector_create(struct vector *);
+void vector_destroy(struct vector *);
+void vector_clear(struct vector *);
+int vector_push(struct vector *, void *);
+void * vector_pop(struct vector *);
+void * vector_top(struct vector *);
+void * vector_get(struct vector *, size_t);
+void * vector_start(struct vector *);
+void * vector_next(struct vector *);
+
+#endif
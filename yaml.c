@@ -2,16 +2,71 @@
 
 #include "yaml_scanner.h"
 
+#if defined(__AVX2__)
+#include "immintrin.h"
+#define YAML_WIDTH 32
+#elif defined(__SSE2__)
+#include "emmintrin.h"
+#define YAML_WIDTH 16
+#endif
+
+/*
+ * yaml_ns is ns-char, yaml_nb is nb-char and yaml_first is
+ * ns-plain-first of the flex scanner without utf-8, yaml_safe
+ * is ns-plain-char without the pairs that involve ':' or '#'
+ * and yaml_known is the subset that yaml_scan reads
+ */
+enum yaml_class {
+    yaml_ns = 0x1,
+    yaml_nb = 0x2,
+    yaml_first = 0x4,
+    yaml_safe = 0x8,
+    yaml_known = 0x10
+};
+
+#define yaml_all (yaml_ns | yaml_nb | yaml_first | yaml_safe | yaml_known)
+
+static const unsigned char yaml_class[256] = {
+    ['\t'] = yaml_nb | yaml_known,
+    ['\n'] = yaml_known,
+    ['\r'] = yaml_known,
+    [' '] = yaml_nb | yaml_known,
+    ['!' ... '"'] = yaml_all,
+    ['#'] = yaml_ns | yaml_nb | yaml_known,
+    ['$' ... ','] = yaml_all,
+    ['-'] = yaml_ns | yaml_nb | yaml_safe | yaml_known,
+    ['.' ... '9'] = yaml_all,
+    [':'] = yaml_ns | yaml_nb | yaml_known,
+    [';' ... '='] = yaml_all,
+    ['>' ... '?'] = yaml_ns | yaml_nb | yaml_safe | yaml_known,
+    ['@' ... '{'] = yaml_all,
+    ['|'] = yaml_ns | yaml_nb | yaml_safe | yaml_known,
+    ['}' ... '~'] = yaml_all
+};
+
 typedef int (* yaml_cb)(struct yaml *);
 typedef int (* yaml_scalar_cb)(struct yaml *, int, int);
 
 static inline int yaml_start(struct yaml *, enum yaml_type);
+static inline void yaml_view(struct yaml *);
 static inline int yaml_next(struct yaml *);
+static inline int yaml_text(struct yaml *);
 static inline int yaml_end(struct yaml *, enum yaml_type);
 
 static inline int yaml_push(struct yaml *, enum yaml_type);
 static inline int yaml_pop(struct yaml *, int);
-
+static inline int yaml_indentless(struct yaml *);
+
+int yaml_stream(struct yaml *, event_cb, void *);
+int yaml_subset(char *, char *);
+char * yaml_safe_end(char *, char *);
+char * yaml_line(char *, char *);
+char * yaml_break(char *, char *);
+char * yaml_empty(char *, char *);
+char * yaml_plain_end(char *, char *);
+int yaml_move(struct yaml *, char *, int);
+int yaml_scan(struct yaml *);
+static inline int yaml_lex(struct yaml *);
 int yaml_document(struct yaml *);
 int yaml_block(struct yaml *);
 int yaml_plain(struct yaml *);
@@ -47,44 +102,334 @@ void yaml_destroy(struct yaml * yaml) {
     pool_destroy(&yaml->pool);
 }
 
-int yaml_parse(struct yaml * yaml, const char * path, event_cb callback, void * context) {
+/*
+ * a chunk within the subset is read by yaml_scan,
+ * anything else goes through the flex scanner
+ */
+int yaml_chunk(struct yaml * yaml, struct chunk * chunk, event_cb callback, void * context) {
+    int status = 0;
+
+    YY_BUFFER_STATE buffer;
+
+    if(yaml_subset(chunk->begin, chunk->end)) {
+        yaml->iter = chunk->begin;
+        yaml->end = chunk->end;
+        yaml->bol = 1;
+        yaml->literal = 0;
+        yaml->fallback = 0;
+
+        if(yaml_stream(yaml, callback, context))
+            status = panic("failed to parse chunk (line %zu)", chunk_lineno(chunk, yaml->iter));
+    } else {
+        yaml->fallback = 1;
+
+        buffer = yaml_scan_bytes(chunk->begin, chunk->end - chunk->begin, yaml->scanner);
+        if(!buffer) {
+            status = panic("failed to scan bytes");
+        } else {
+            yamlset_lineno(chunk_lineno(chunk, chunk->begin), yaml->scanner);
+
+            if(yaml_stream(yaml, callback, context))
+                status = panic("failed to parse chunk (line %zu)", chunk_lineno(chunk, chunk->begin));
+
+            yaml_delete_buffer(buffer, yaml->scanner);
+        }
+    }
+
+    return status;
+}
+
+int yaml_stream(struct yaml * yaml, event_cb callback, void * context) {
     int status = 0;
 
-    FILE * file;
     struct yaml_node * node;
 
-    file = fopen(path, "r");
-    if(!file) {
-        status = panic("failed to open %s", path);
+    yaml->root = NULL;
+    strbuf_clear(&yaml->strbuf);
+    yaml->string = NULL;
+    yaml->length = 0;
+    yaml->view.string = NULL;
+    yaml->view.length = 0;
+    yaml->space = 0;
+    yaml->token = 0;
+    yaml->scope = 0;
+    yaml->scalar = 0;
+    yaml->callback = callback;
+    yaml->context = context;
+
+    if(yaml_document(yaml)) {
+        status = panic("failed to document yaml object");
+    } else if(yaml_pop(yaml, -1)) {
+        status = panic("failed to pop yaml object");
+    }
+
+    while(yaml->root) {
+        node = yaml->root;
+        yaml->root = yaml->root->next;
+        pool_put(&yaml->pool, node);
+    }
+
+    return status;
+}
+
+/*
+ * the subset is tab, newline and 0x20-0x7E
+ */
+int yaml_subset(char * iter, char * end) {
+#if defined(__AVX2__)
+    __m256i x;
+    __m256i m;
+
+    while(iter + YAML_WIDTH <= end) {
+        x = _mm256_loadu_si256((__m256i *) iter);
+        m = _mm256_cmpgt_epi8(_mm256_set1_epi8(0x20), x);
+        m = _mm256_andnot_si256(_mm256_cmpeq_epi8(x, _mm256_set1_epi8('\t')), m);
+        m = _mm256_andnot_si256(_mm256_cmpeq_epi8(x, _mm256_set1_epi8('\n')), m);
+        m = _mm256_andnot_si256(_mm256_cmpeq_epi8(x, _mm256_set1_epi8('\r')), m);
+        m = _mm256_or_si256(m, _mm256_cmpeq_epi8(x, _mm256_set1_epi8(0x7F)));
+        if(_mm256_movemask_epi8(m))
+            return 0;
+        iter += YAML_WIDTH;
+    }
+#elif defined(__SSE2__)
+    __m128i x;
+    __m128i m;
+
+    while(iter + YAML_WIDTH <= end) {
+        x = _mm_loadu_si128((__m128i *) iter);
+        m = _mm_cmplt_epi8(x, _mm_set1_epi8(0x20));
+        m = _mm_andnot_si128(_mm_cmpeq_epi8(x, _mm_set1_epi8('\t')), m);
+        m = _mm_andnot_si128(_mm_cmpeq_epi8(x, _mm_set1_epi8('\n')), m);
+        m = _mm_andnot_si128(_mm_cmpeq_epi8(x, _mm_set1_epi8('\r')), m);
+        m = _mm_or_si128(m, _mm_cmpeq_epi8(x, _mm_set1_epi8(0x7F)));
+        if(_mm_movemask_epi8(m))
+            return 0;
+        iter += YAML_WIDTH;
+    }
+#endif
+    while(iter < end)
+        if(!(yaml_class[(unsigned char) *iter++] & yaml_known))
+            return 0;
+
+    return 1;
+}
+
+/*
+ * return the first byte that is not yaml_safe,
+ * i.e. a space, break, ':' or '#'
+ */
+char * yaml_safe_end(char * iter, char * end) {
+#if defined(__AVX2__)
+    __m256i x;
+    __m256i m;
+    unsigned int mask;
+
+    while(iter + YAML_WIDTH <= end) {
+        x = _mm256_loadu_si256((__m256i *) iter);
+        m = _mm256_cmpgt_epi8(_mm256_set1_epi8(0x21), x);
+        m = _mm256_or_si256(m, _mm256_cmpeq_epi8(x, _mm256_set1_epi8(0x7F)));
+        m = _mm256_or_si256(m, _mm256_cmpeq_epi8(x, _mm256_set1_epi8(':')));
+        m = _mm256_or_si256(m, _mm256_cmpeq_epi8(x, _mm256_set1_epi8('#')));
+        mask = _mm256_movemask_epi8(m);
+        if(mask)
+            return iter + __builtin_ctz(mask);
+        iter += YAML_WIDTH;
+    }
+#elif defined(__SSE2__)
+    __m128i x;
+    __m128i m;
+    unsigned int mask;
+
+    while(iter + YAML_WIDTH <= end) {
+        x = _mm_loadu_si128((__m128i *) iter);
+        m = _mm_cmplt_epi8(x, _mm_set1_epi8(0x21));
+        m = _mm_or_si128(m, _mm_cmpeq_epi8(x, _mm_set1_epi8(0x7F)));
+        m = _mm_or_si128(m, _mm_cmpeq_epi8(x, _mm_set1_epi8(':')));
+        m = _mm_or_si128(m, _mm_cmpeq_epi8(x, _mm_set1_epi8('#')));
+        mask = _mm_movemask_epi8(m);
+        if(mask)
+            return iter + __builtin_ctz(mask);
+        iter += YAML_WIDTH;
+    }
+#endif
+    while(iter < end && yaml_class[(unsigned char) *iter] & yaml_safe)
+        iter++;
+
+    return iter;
+}
+
+char * yaml_line(char * iter, char * end) {
+    char * line;
+    char * feed;
+
+    line = memchr(iter, '\n', end - iter);
+    if(!line)
+        line = end;
+    feed = memchr(iter, '\r', line - iter);
+
+    return feed ? feed : line;
+}
+
+/*
+ * return the end of b-break at iter or NULL
+ */
+char * yaml_break(char * iter, char * end) {
+    if(iter < end) {
+        if(iter[0] == '\r')
+            return iter + 1 < end && iter[1] == '\n' ? iter + 2 : iter + 1;
+        if(iter[0] == '\n')
+            return iter + 1;
+    }
+
+    return NULL;
+}
+
+/*
+ * return the end of c-nb-comment-text? b-break at iter or NULL
+ */
+char * yaml_empty(char * iter, char * end) {
+    if(iter < end && iter[0] == '#')
+        iter = yaml_line(iter, end);
+
+    return yaml_break(iter, end);
+}
+
+/*
+ * return the end of the longest ns-plain-one-line at iter or NULL;
+ * bit k of valid is set if the match can end at iter + k, space
+ * is set if a ns-plain-char can start at iter after spaces
+ */
+char * yaml_plain_end(char * iter, char * end) {
+    char * last;
+    char * safe;
+    size_t count;
+    unsigned int valid;
+    unsigned int next;
+    int space = 0;
+    int start;
+
+    if(iter < end && yaml_class[(unsigned char) iter[0]] & yaml_first) {
+        iter += 1;
+    } else if(iter + 1 < end && (iter[0] == '-' || iter[0] == '?' || iter[0] == ':') && yaml_class[(unsigned char) iter[1]] & yaml_ns) {
+        iter += 2;
     } else {
-        yaml->root = NULL;
-        strbuf_clear(&yaml->strbuf);
-        yamlrestart(file, yaml->scanner);
-        yaml->string = NULL;
-        yaml->length = 0;
-        yaml->space = 0;
-        yaml->token = 0;
-        yaml->scope = 0;
-        yaml->scalar = 0;
-        yaml->callback = callback;
-        yaml->context = context;
+        return NULL;
+    }
 
-        if(yaml_document(yaml)) {
-            status = panic("failed to document yaml object");
-        } else if(yaml_pop(yaml, -1)) {
-            status = panic("failed to pop yaml object");
+    last = iter;
+    valid = 1;
+    while(iter < end && (valid || space)) {
+        start = valid & 1 || space;
+        if(start && yaml_class[(unsigned char) iter[0]] & yaml_safe) {
+            safe = yaml_safe_end(iter + 1, end);
+            count = safe - iter;
+            valid = 1 | (count < 3 ? valid >> count : 0);
+            if(safe < end && safe[0] == '#')
+                valid |= 2;
+            space = 0;
+            iter = safe;
+        } else {
+            next = valid >> 1;
+            if(start && iter + 1 < end) {
+                if(yaml_class[(unsigned char) iter[0]] & yaml_ns && iter[1] == '#')
+                    next |= 2;
+                if(iter[0] == ':' && yaml_class[(unsigned char) iter[1]] & yaml_ns)
+                    next |= 2;
+            }
+            space = start && iter[0] == ' ';
+            valid = next;
+            iter++;
         }
 
-        while(yaml->root) {
-            node = yaml->root;
-            yaml->root = yaml->root->next;
-            pool_put(&yaml->pool, node);
+        if(valid & 1)
+            last = iter;
+    }
+
+    return last;
+}
+
+int yaml_move(struct yaml * yaml, char * iter, int token) {
+    yaml->bol = iter[-1] == '\n';
+    yaml->iter = iter;
+
+    return token;
+}
+
+/*
+ * same tokens as yaml_scanner.l for input within the subset;
+ * the longest rule wins and the first on a tie, s-indent and
+ * l-empty only match at the beginning of a line
+ */
+int yaml_scan(struct yaml * yaml) {
+    char * iter;
+    char * end;
+    char * text;
+    size_t space;
+
+    iter = yaml->iter;
+    end = yaml->end;
+    if(iter >= end)
+        return end_of_file;
+
+    if(yaml->literal) {
+        if(yaml_class[(unsigned char) iter[0]] & yaml_ns) {
+            text = yaml_line(iter, end);
+            yaml->literal = 0;
+            yaml->string = iter;
+            yaml->length = text - iter;
+            return yaml_move(yaml, text, nb_char);
         }
+    } else {
+        space = 0;
+        while(iter + space < end && iter[space] == ' ')
+            space++;
+
+        if(yaml->bol) {
+            text = yaml_empty(iter + space, end);
+            if(text)
+                return yaml_move(yaml, text, l_empty);
+
+            if(space) {
+                if(yaml->scalar && yaml->scope <= space)
+                    yaml->literal = 1;
+                yaml->space = space;
+                return yaml_move(yaml, iter + space, s_indent);
+            }
+        } else if(space) {
+            text = yaml_empty(iter + space, end);
+            if(text)
+                return yaml_move(yaml, text, b_break);
 
-        fclose(file);
+            yaml->space = space;
+            return yaml_move(yaml, iter + space, s_separate_in_line);
+        } else {
+            text = yaml_break(iter, end);
+            if(text)
+                return yaml_move(yaml, text, b_break);
+        }
+
+        text = yaml_plain_end(iter, end);
+        if(text) {
+            yaml->string = iter;
+            yaml->length = text - iter;
+            return yaml_move(yaml, text, ns_plain_one_line);
+        }
+
+        switch(iter[0]) {
+            case '-': return yaml_move(yaml, iter + 1, c_sequence_entry);
+            case ':': return yaml_move(yaml, iter + 1, c_mapping_value);
+            case '|': return yaml_move(yaml, iter + 1, c_literal);
+            case '>': return yaml_move(yaml, iter + 1, c_folded);
+        }
     }
 
-    return status;
+    text = yaml_break(iter, end);
+
+    return yaml_move(yaml, text ? text : iter + 1, -1);
+}
+
+static inline int yaml_lex(struct yaml * yaml) {
+    return yaml->fallback ? yamllex(yaml->scanner) : yaml_scan(yaml);
 }
 
 static inline int yaml_start(struct yaml * yaml, enum yaml_type type) {
@@ -103,8 +448,26 @@ static inline int yaml_start(struct yaml * yaml, enum yaml_type type) {
     return status;
 }
 
+/*
+ * keep the plain scalar of the last token, it stays valid
+ * while the scanner reads on since the input is in memory
+ */
+static inline void yaml_view(struct yaml * yaml) {
+    yaml->view.string = yaml->string;
+    yaml->view.length = yaml->length;
+}
+
 static inline int yaml_next(struct yaml * yaml) {
     int status = 0;
+
+    if(yaml->callback(event_scalar, &yaml->view, yaml->context))
+        status = panic("failed to process scalar event");
+
+    return status;
+}
+
+static inline int yaml_text(struct yaml * yaml) {
+    int status = 0;
     struct string * string;
 
     string = strbuf_string(&yaml->strbuf);
@@ -139,7 +502,9 @@ static inline int yaml_push(struct yaml * yaml, enum yaml_type type) {
     int status = 0;
     struct yaml_node * node;
 
-    if(yaml->root && yaml->root->scope >= yaml->scope) {
+    if(yaml->root && yaml->root->scope > yaml->scope) {
+        status = panic("invalid scope");
+    } else if(yaml->root && yaml->root->scope == yaml->scope && (type != yaml_sequence || yaml->root->type != yaml_map)) {
         status = panic("invalid scope");
     } else {
         node = pool_get(&yaml->pool);
@@ -176,30 +541,53 @@ static inline int yaml_pop(struct yaml * yaml, int scope) {
     return status;
 }
 
+/*
+ * a sequence in the scope of its map, the value of a key
+ * whose entries are not indented, ends at the next key
+ */
+static inline int yaml_indentless(struct yaml * yaml) {
+    int status = 0;
+    struct yaml_node * node;
+
+    node = yaml->root;
+    if(node && node->type == yaml_sequence && node->next && node->next->scope == node->scope && yaml->token != c_sequence_entry) {
+        if(yaml_end(yaml, node->type)) {
+            status = panic("failed to end yaml object");
+        } else {
+            yaml->root = node->next;
+            pool_put(&yaml->pool, node);
+        }
+    }
+
+    return status;
+}
+
 int yaml_document(struct yaml * yaml) {
     int status = 0;
 
-    yaml->token = yamllex(yaml->scanner);
+    yaml->token = yaml_lex(yaml);
     while(yaml->token == l_empty)
-        yaml->token = yamllex(yaml->scanner);
+        yaml->token = yaml_lex(yaml);
 
     while(yaml->token && !status) {
         yaml->scope = 0;
 
         if(yaml->token == s_indent) {
             yaml->scope = yaml->space;
-            yaml->token = yamllex(yaml->scanner);
+            yaml->token = yaml_lex(yaml);
         }
 
         if(yaml_pop(yaml, yaml->scope)) {
             status = panic("failed to pop yaml object");
+        } else if(yaml_indentless(yaml)) {
+            status = panic("failed to indentless yaml object");
         } else {
             if(yaml->root) {
                 if(yaml->root->scope != yaml->scope) {
                     status = panic("invalid scope");
                 } else if(yaml->root->type == yaml_sequence) {
                     if(yaml->token == c_sequence_entry) {
-                        yaml->token = yamllex(yaml->scanner);
+                        yaml->token = yaml_lex(yaml);
 
                         if(yaml_container(yaml, yaml_block))
                             status = panic("failed to container yaml object");
@@ -208,22 +596,19 @@ int yaml_document(struct yaml * yaml) {
                     }
                 } else if(yaml->root->type == yaml_map) {
                     if(yaml->token == ns_plain_one_line) {
-                        if(strbuf_strcpy(&yaml->strbuf, yaml->string, yaml->length)) {
-                            status = panic("failed to strcpy strbuf object");
-                        } else {
-                            yaml->token = yamllex(yaml->scanner);
+                        yaml_view(yaml);
+                        yaml->token = yaml_lex(yaml);
 
-                            if(yaml->token == c_mapping_value) {
-                                yaml->token = yamllex(yaml->scanner);
+                        if(yaml->token == c_mapping_value) {
+                            yaml->token = yaml_lex(yaml);
 
-                                if(yaml_next(yaml)) {
-                                    status = panic("failed to next yaml object");
-                                } else if(yaml_container(yaml, yaml_plain)) {
-                                    status = panic("failed to container yaml object");
-                                }
-                            } else {
-                                status = panic("expected mapping value");
+                            if(yaml_next(yaml)) {
+                                status = panic("failed to next yaml object");
+                            } else if(yaml_container(yaml, yaml_plain)) {
+                                status = panic("failed to container yaml object");
                             }
+                        } else {
+                            status = panic("expected mapping value");
                         }
                     } else {
                         status = panic("expected mapping key");
@@ -244,34 +629,31 @@ int yaml_block(struct yaml * yaml) {
     int status = 0;
 
     if(yaml->token == ns_plain_one_line) {
-        if(strbuf_strcpy(&yaml->strbuf, yaml->string, yaml->length)) {
-            status = panic("failed to strcpy strbuf object");
-        } else {
-            yaml->token = yamllex(yaml->scanner);
-
-            if(yaml->token == b_break) {
-                yaml->token = yamllex(yaml->scanner);
-                while(yaml->token == l_empty)
-                    yaml->token = yamllex(yaml->scanner);
-
-                if(yaml_next(yaml))
-                    status = panic("failed to next yaml object");
-            } else if(yaml->token == c_mapping_value) {
-                yaml->token = yamllex(yaml->scanner);
-
-                if(yaml_push(yaml, yaml_map)) {
-                    status = panic("failed to start yaml object");
-                } else if(yaml_next(yaml)) {
-                    status = panic("failed to next yaml object");
-                } else if(yaml_container(yaml, yaml_plain)) {
-                    status = panic("failed to container yaml object");
-                }
-            } else {
-                status = panic("expected newline or mapping value");
+        yaml_view(yaml);
+        yaml->token = yaml_lex(yaml);
+
+        if(yaml->token == b_break) {
+            yaml->token = yaml_lex(yaml);
+            while(yaml->token == l_empty)
+                yaml->token = yaml_lex(yaml);
+
+            if(yaml_next(yaml))
+                status = panic("failed to next yaml object");
+        } else if(yaml->token == c_mapping_value) {
+            yaml->token = yaml_lex(yaml);
+
+            if(yaml_push(yaml, yaml_map)) {
+                status = panic("failed to start yaml object");
+            } else if(yaml_next(yaml)) {
+                status = panic("failed to next yaml object");
+            } else if(yaml_container(yaml, yaml_plain)) {
+                status = panic("failed to container yaml object");
             }
+        } else {
+            status = panic("expected newline or mapping value");
         }
     } else if(yaml->token == c_sequence_entry) {
-        yaml->token = yamllex(yaml->scanner);
+        yaml->token = yaml_lex(yaml);
         if(yaml_push(yaml, yaml_sequence)) {
             status = panic("failed ot start yaml object");
         } else if(yaml_container(yaml, yaml_block)) {
@@ -288,34 +670,31 @@ int yaml_plain(struct yaml * yaml) {
     int status = 0;
 
     if(yaml->token == ns_plain_one_line) {
-        if(strbuf_strcpy(&yaml->strbuf, yaml->string, yaml->length)) {
-            status = panic("failed to strcpy strbuf object");
-        } else {
-            yaml->token = yamllex(yaml->scanner);
+        yaml_view(yaml);
+        yaml->token = yaml_lex(yaml);
 
-            if(yaml->token == b_break) {
-                yaml->token = yamllex(yaml->scanner);
-                while(yaml->token == l_empty)
-                    yaml->token = yamllex(yaml->scanner);
+        if(yaml->token == b_break) {
+            yaml->token = yaml_lex(yaml);
+            while(yaml->token == l_empty)
+                yaml->token = yaml_lex(yaml);
 
-                if(yaml_next(yaml))
-                    status = panic("failed to next yaml object");
-            } else {
-                status = panic("expected newline");
-            }
+            if(yaml_next(yaml))
+                status = panic("failed to next yaml object");
+        } else {
+            status = panic("expected newline");
         }
     } else if(yaml->token == c_literal) {
-        yaml->token = yamllex(yaml->scanner);
+        yaml->token = yaml_lex(yaml);
         if(yaml_scalar(yaml, yaml_literal)) {
             status = panic("failed to scalar yaml object");
-        } else if(yaml_next(yaml)) {
+        } else if(yaml_text(yaml)) {
             status = panic("failed to next yaml object");
         }
     } else if(yaml->token == c_folded) {
-        yaml->token = yamllex(yaml->scanner);
+        yaml->token = yaml_lex(yaml);
         if(yaml_scalar(yaml, yaml_folded)) {
             status = panic("failed to scalar yaml object");
-        } else if(yaml_next(yaml)) {
+        } else if(yaml_text(yaml)) {
             status = panic("failed to next yaml object");
         }
     } else {
@@ -330,18 +709,23 @@ int yaml_container(struct yaml * yaml, yaml_cb callback) {
 
     if(yaml->token == s_separate_in_line) {
         yaml->scope += yaml->space + 1;
-        yaml->token = yamllex(yaml->scanner);
+        yaml->token = yaml_lex(yaml);
 
         if(callback(yaml))
             status = panic("failed to block yaml object");
     } else if(yaml->token == b_break) {
-        yaml->token = yamllex(yaml->scanner);
+        yaml->token = yaml_lex(yaml);
         while(yaml->token == l_empty)
-            yaml->token = yamllex(yaml->scanner);
+            yaml->token = yaml_lex(yaml);
 
         if(yaml->token == s_indent) {
             yaml->scope = yaml->space;
-            yaml->token = yamllex(yaml->scanner);
+            yaml->token = yaml_lex(yaml);
+
+            if(yaml_block(yaml))
+                status = panic("failed to block yaml object");
+        } else if(yaml->token == c_sequence_entry) {
+            yaml->scope = 0;
 
             if(yaml_block(yaml))
                 status = panic("failed to block yaml object");
@@ -365,9 +749,9 @@ int yaml_scalar(struct yaml * yaml, yaml_scalar_cb callback) {
     yaml->scope = yaml->root ? yaml->root->scope : 0;
 
     if(yaml->token == b_break) {
-        yaml->token = yamllex(yaml->scanner);
+        yaml->token = yaml_lex(yaml);
         while(yaml->token == l_empty)
-            yaml->token = yamllex(yaml->scanner);
+            yaml->token = yaml_lex(yaml);
 
         if(yaml->token == s_indent) {
             if(yaml->scope < yaml->space) {
@@ -382,20 +766,20 @@ int yaml_scalar(struct yaml * yaml, yaml_scalar_cb callback) {
                         if(strbuf_putcn(&yaml->strbuf, ' ', space)) {
                             status = panic("failed to putcn strbuf object");
                         } else {
-                            yaml->token = yamllex(yaml->scanner);
+                            yaml->token = yaml_lex(yaml);
 
                             if(yaml->token == nb_char) {
                                 if(strbuf_strcpy(&yaml->strbuf, yaml->string, yaml->length)) {
                                     status = panic("failed to strcpy strbuf object");
                                 } else {
-                                    yaml->token = yamllex(yaml->scanner);
+                                    yaml->token = yaml_lex(yaml);
 
                                     if(yaml->token == b_break) {
                                         newline = 1;
-                                        yaml->token = yamllex(yaml->scanner);
+                                        yaml->token = yaml_lex(yaml);
                                         while(yaml->token == l_empty) {
                                             newline++;
-                                            yaml->token = yamllex(yaml->scanner);
+                                            yaml->token = yaml_lex(yaml);
                                         }
                                     } else {
                                         status = panic("expected newline");
@@ -3,6 +3,7 @@
 
 #include "pool.h"
 #include "event.h"
+#include "chunk.h"
 
 enum yaml_token {
     end_of_file = 0,
@@ -34,8 +35,14 @@ struct yaml {
     struct yaml_node * root;
     struct strbuf strbuf;
     void * scanner;
+    char * iter;
+    char * end;
+    int bol;
+    int literal;
+    int fallback;
     char * string;
     size_t length;
+    struct string view;
     size_t space;
     enum yaml_token token;
     int scope;
@@ -46,6 +53,6 @@ struct yaml {
 
 int yaml_create(struct yaml *, size_t);
 void yaml_destroy(struct yaml *);
-int yaml_parse(struct yaml *, const char *, event_cb, void *);
+int yaml_chunk(struct yaml *, struct chunk *, event_cb, void *);
 
 #endif